@@ -0,0 +1,281 @@
+﻿// 구현 간 처리량/동등성 비교 하네스
+// Orignal, mission1, mission2(및 새 입력 경로)를 같은 생성 입력으로 실행하고
+// 기준 구현(기본 mission2)의 출력과 비교, 경과 시간/처리량/최대 RSS를 표로 출력함
+//
+// 사용법
+//   harness --impl orignal=<exe> --impl mission1=<exe> --impl mission2=<exe>
+//           [--impl "mission2-external=<exe> --external attendance_weekday_500.txt 4096"]
+//           [--reference mission2] [--case <records>:<players>]... [--repeat N] [--work <dir>]
+//
+// 각 구현은 작업 디렉터리에서 실행되며 그 안의 attendance_weekday_500.txt를 입력으로 받음
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#include <direct.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+struct Impl {
+    std::string name;
+    std::vector<std::string> argv; // argv[0] = 실행 파일 (절대 경로)
+};
+
+struct Case {
+    int records;
+    int players;
+};
+
+struct RunResult {
+    bool started;
+    bool exited;     // 정상 종료 (시그널/예외 종료가 아님)
+    int exitCode;
+    double seconds;
+    long peakKb;
+};
+
+static const char* kInputName = "attendance_weekday_500.txt";
+static const char* kDays[] = { "monday", "tuesday", "wednesday", "thursday", "friday", "saturday", "sunday" };
+
+static std::vector<std::string> splitWords(const std::string& s) {
+    std::vector<std::string> out;
+    std::istringstream iss(s);
+    std::string w;
+    while (iss >> w) out.push_back(w);
+    return out;
+}
+
+static std::string absolutePath(const std::string& p) {
+#ifdef _WIN32
+    char buf[MAX_PATH];
+    return _fullpath(buf, p.c_str(), MAX_PATH) ? std::string(buf) : p;
+#else
+    char buf[PATH_MAX];
+    return realpath(p.c_str(), buf) ? std::string(buf) : p;
+#endif
+}
+
+static bool makeDirectory(const std::string& dir) {
+#ifdef _WIN32
+    return _mkdir(dir.c_str()) == 0 || errno == EEXIST;
+#else
+    return mkdir(dir.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+}
+
+// 플레이어 번호가 작을수록 자주 등장하는 결정적 입력
+static bool generateInput(const std::string& path, const Case& c, unsigned seed) {
+    std::ofstream fout(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!fout.is_open()) { std::cerr << "Failed to open file: " << path << "\n"; return false; }
+    std::string buf;
+    buf.reserve(1 << 16);
+    for (int i = 0; i < c.records; ++i) {
+        seed = seed * 1103515245u + 12345u; unsigned a = (seed >> 8) % (unsigned)c.players;
+        seed = seed * 1103515245u + 12345u; unsigned b = (seed >> 8) % (unsigned)c.players;
+        seed = seed * 1103515245u + 12345u;
+        unsigned who = (i < c.players) ? (unsigned)i : (unsigned)((unsigned long long)a * (b + 1) / c.players) % (unsigned)c.players;
+        char line[64];
+        std::snprintf(line, sizeof(line), "P%u %s\n", who, kDays[(seed >> 8) % 7]);
+        buf += line;
+        if (buf.size() > (1 << 16) - 64) { fout << buf; buf.clear(); }
+    }
+    fout << buf;
+    return (bool)fout;
+}
+
+static bool readFile(const std::string& path, std::string& out) {
+    std::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+    if (!fin.is_open()) return false;
+    std::ostringstream oss; oss << fin.rdbuf();
+    out = oss.str();
+    out.erase(std::remove(out.begin(), out.end(), '\r'), out.end()); // 줄바꿈 차이는 무시
+    return true;
+}
+
+#ifdef _WIN32
+static std::string quoteArg(const std::string& a) {
+    if (!a.empty() && a.find_first_of(" \t\"") == std::string::npos) return a;
+    std::string q = "\"";
+    for (size_t i = 0; i < a.size(); ++i) { if (a[i] == '"') q += '\\'; q += a[i]; }
+    return q + "\"";
+}
+#endif
+
+// workDir에서 실행, stdout -> outPath, stderr 버림
+static RunResult runProcess(const Impl& impl, const std::string& workDir, const std::string& outPath) {
+    RunResult r; r.started = false; r.exited = false; r.exitCode = -1; r.seconds = 0; r.peakKb = 0;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+#ifdef _WIN32
+    SECURITY_ATTRIBUTES sa; sa.nLength = sizeof(sa); sa.lpSecurityDescriptor = 0; sa.bInheritHandle = TRUE;
+    HANDLE out = CreateFileA(outPath.c_str(), GENERIC_WRITE, 0, &sa, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0);
+    HANDLE nul = CreateFileA("NUL", GENERIC_WRITE, FILE_SHARE_WRITE, &sa, OPEN_EXISTING, 0, 0);
+    if (out == INVALID_HANDLE_VALUE) return r;
+    STARTUPINFOA si; ZeroMemory(&si, sizeof(si)); si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES; si.hStdOutput = out; si.hStdError = nul; si.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    PROCESS_INFORMATION pi;
+    std::string cmd;
+    for (size_t i = 0; i < impl.argv.size(); ++i) cmd += (i ? " " : "") + quoteArg(impl.argv[i]);
+    std::vector<char> cmdBuf(cmd.begin(), cmd.end()); cmdBuf.push_back('\0');
+    t0 = std::chrono::steady_clock::now();
+    BOOL ok = CreateProcessA(0, &cmdBuf[0], 0, 0, TRUE, 0, 0, workDir.c_str(), &si, &pi);
+    CloseHandle(out); CloseHandle(nul);
+    if (!ok) return r;
+    r.started = true;
+    WaitForSingleObject(pi.hProcess, INFINITE);
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    DWORD code = 0; GetExitCodeProcess(pi.hProcess, &code);
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(pi.hProcess, &pmc, sizeof(pmc))) r.peakKb = (long)(pmc.PeakWorkingSetSize / 1024);
+    r.exitCode = (int)code;
+    r.exited = code < 0xC0000000u; // NTSTATUS 예외 코드는 비정상 종료
+    CloseHandle(pi.hThread); CloseHandle(pi.hProcess);
+#else
+    std::vector<char*> args;
+    for (size_t i = 0; i < impl.argv.size(); ++i) args.push_back(const_cast<char*>(impl.argv[i].c_str()));
+    args.push_back(0);
+    t0 = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid < 0) return r;
+    if (pid == 0) {
+        int out = open(outPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int nul = open("/dev/null", O_WRONLY);
+        if (out < 0 || chdir(workDir.c_str()) != 0) _exit(127);
+        dup2(out, 1); dup2(nul, 2);
+        execv(args[0], &args[0]);
+        _exit(127);
+    }
+    r.started = true;
+    int status = 0;
+    struct rusage ru;
+    wait4(pid, &status, 0, &ru);
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    r.peakKb = ru.ru_maxrss; // Linux: KB 단위
+    r.exited = WIFEXITED(status);
+    r.exitCode = r.exited ? WEXITSTATUS(status) : -WTERMSIG(status);
+    if (r.exited && r.exitCode == 127) r.started = false;
+#endif
+    return r;
+}
+
+static bool parseCase(const std::string& s, Case& c) {
+    size_t colon = s.find(':');
+    if (colon == std::string::npos) return false;
+    c.records = std::atoi(s.substr(0, colon).c_str());
+    c.players = std::atoi(s.substr(colon + 1).c_str());
+    return c.records > 0 && c.players > 0;
+}
+
+static void usage() {
+    std::cerr << "usage: harness --impl <name>=<exe> [args...] ... [--reference <name>]\n"
+        "               [--case <records>:<players>]... [--repeat N] [--work <dir>]\n";
+}
+
+int main(int argc, char** argv) {
+    std::vector<Impl> impls;
+    std::vector<Case> cases;
+    std::string reference = "mission2";
+    std::string workDir = "harness_work";
+    int repeat = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--impl" && i + 1 < argc) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            if (eq == std::string::npos) { usage(); return 2; }
+            Impl impl; impl.name = spec.substr(0, eq);
+            impl.argv = splitWords(spec.substr(eq + 1));
+            if (impl.argv.empty()) { usage(); return 2; }
+            impl.argv[0] = absolutePath(impl.argv[0]);
+            impls.push_back(impl);
+        } else if (a == "--case" && i + 1 < argc) {
+            Case c; if (!parseCase(argv[++i], c)) { usage(); return 2; }
+            cases.push_back(c);
+        } else if (a == "--reference" && i + 1 < argc) {
+            reference = argv[++i];
+        } else if (a == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (a == "--work" && i + 1 < argc) {
+            workDir = argv[++i];
+        } else {
+            usage(); return 2;
+        }
+    }
+    if (impls.empty()) { usage(); return 2; }
+    if (cases.empty()) {
+        // 원본의 고정 배열(100명, 500줄) 안/밖을 모두 포함
+        const Case defaults[] = { { 500, 19 }, { 500, 99 }, { 5000, 150 }, { 50000, 1000 }, { 500000, 20000 } };
+        cases.assign(defaults, defaults + sizeof(defaults) / sizeof(defaults[0]));
+    }
+
+    size_t refIdx = impls.size();
+    for (size_t i = 0; i < impls.size(); ++i) if (impls[i].name == reference) refIdx = i;
+    if (refIdx == impls.size()) { std::cerr << "Unknown reference implementation: " << reference << "\n"; return 2; }
+    if (!makeDirectory(workDir)) { std::cerr << "Failed to create directory: " << workDir << "\n"; return 1; }
+    workDir = absolutePath(workDir);
+
+    std::cout << std::left << std::setw(20) << "IMPL" << std::right << std::setw(9) << "RECORDS" << std::setw(9) << "PLAYERS"
+        << std::setw(11) << "TIME(ms)" << std::setw(14) << "RECORDS/s" << std::setw(12) << "PEAK(KB)" << "  RESULT\n";
+
+    int mismatches = 0;
+    for (size_t ci = 0; ci < cases.size(); ++ci) {
+        const Case& c = cases[ci];
+        const std::string input = workDir + "/" + kInputName;
+        if (!generateInput(input, c, 20240601u + (unsigned)ci)) return 1;
+
+        std::vector<std::string> outputs(impls.size());
+        std::vector<RunResult> results(impls.size());
+        // 기준 구현을 먼저 실행
+        std::vector<size_t> order(1, refIdx);
+        for (size_t i = 0; i < impls.size(); ++i) if (i != refIdx) order.push_back(i);
+
+        for (size_t oi = 0; oi < order.size(); ++oi) {
+            size_t i = order[oi];
+            const std::string outPath = workDir + "/" + impls[i].name + ".out";
+            RunResult best; best.started = false;
+            for (int rep = 0; rep < repeat; ++rep) {
+                RunResult r = runProcess(impls[i], workDir, outPath);
+                if (!best.started || (r.started && r.seconds < best.seconds)) best = r;
+                if (!r.started || !r.exited) break;
+            }
+            results[i] = best;
+            readFile(outPath, outputs[i]);
+
+            std::string verdict;
+            if (!best.started) verdict = "NOT STARTED";
+            else if (!best.exited) verdict = "CRASH";
+            else if (i == refIdx) verdict = "REFERENCE";
+            else if (outputs[i] == outputs[refIdx]) verdict = "OK";
+            else verdict = "DIFF";
+            if (i != refIdx && verdict != "OK") ++mismatches;
+
+            double ms = best.seconds * 1000.0;
+            double rps = best.seconds > 0 ? c.records / best.seconds : 0;
+            std::cout << std::left << std::setw(20) << impls[i].name << std::right << std::setw(9) << c.records << std::setw(9) << c.players
+                << std::setw(11) << std::fixed << std::setprecision(1) << ms << std::setw(14) << std::setprecision(0) << rps
+                << std::setw(12) << best.peakKb << "  " << verdict;
+            if (best.started && best.exitCode != 0) std::cout << " (exit " << best.exitCode << ")";
+            std::cout << "\n";
+        }
+    }
+    return mismatches == 0 ? 0 : 1;
+}
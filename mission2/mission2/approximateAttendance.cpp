@@ -0,0 +1,253 @@
+﻿#include "approximateAttendance.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace {
+
+unsigned long long mix64(unsigned long long x) { // splitmix64 finalizer
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+unsigned long long hashName(const std::string& s) {
+    unsigned long long h = 1469598103934665603ULL; // FNV-1a
+    for (size_t i = 0; i < s.size(); ++i) { h ^= (unsigned char)s[i]; h *= 1099511628211ULL; }
+    return mix64(h);
+}
+
+unsigned long long hashNameDay(unsigned long long nameHash, Weekday day) {
+    return mix64(nameHash + 0x9e3779b97f4a7c15ULL * ((unsigned long long)day + 1));
+}
+
+const size_t kMapNodeOverhead = 4 * sizeof(void*); // std::map 노드의 트리 포인터/색
+
+// 이름 버퍼 용량 상한 (문자열 구현은 용량을 16바이트 단위 정도로 올림)
+size_t nameCapacityLimit(size_t maxNameBytes) { return (maxNameBytes | 15) + 1; }
+
+bool greaterEstimate(const HeavyHitter& a, const HeavyHitter& b) {
+    if (a.estimate != b.estimate) return a.estimate > b.estimate;
+    return a.name < b.name;
+}
+
+} // namespace
+
+// HyperLogLog
+HyperLogLog::HyperLogLog(int precision) : p_(precision) {
+    if (p_ < 4) p_ = 4;
+    if (p_ > 16) p_ = 16;
+    regs_.assign((size_t)1 << p_, 0);
+}
+
+void HyperLogLog::add(unsigned long long hash) {
+    size_t idx = (size_t)(hash >> (64 - p_));
+    unsigned long long rest = (hash << p_) | ((unsigned long long)1 << (p_ - 1)); // 0 방지용 보초 비트
+    unsigned char rank = 1;
+    while (!(rest & 0x8000000000000000ULL)) { rest <<= 1; ++rank; }
+    if (rank > regs_[idx]) regs_[idx] = rank;
+}
+
+double HyperLogLog::estimate() const {
+    const double m = (double)regs_.size();
+    double sum = 0.0;
+    int zeros = 0;
+    for (size_t i = 0; i < regs_.size(); ++i) {
+        sum += std::ldexp(1.0, -(int)regs_[i]);
+        if (regs_[i] == 0) ++zeros;
+    }
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double e = alpha * m * m / sum;
+    if (e <= 2.5 * m && zeros > 0) e = m * std::log(m / zeros); // 작은 범위 보정 (linear counting)
+    return e;
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    if (other.p_ != p_) return;
+    for (size_t i = 0; i < regs_.size(); ++i) regs_[i] = std::max(regs_[i], other.regs_[i]);
+}
+
+void HyperLogLog::clear() { std::fill(regs_.begin(), regs_.end(), (unsigned char)0); }
+
+size_t HyperLogLog::memoryBytes() const { return regs_.size(); }
+
+// CountMinSketch
+CountMinSketch::CountMinSketch(int width, int depth)
+    : width_(width > 0 ? width : 1), depth_(depth > 0 ? depth : 1), total_(0),
+    cells_((size_t)width_ * depth_, 0) {
+}
+
+unsigned long long CountMinSketch::add(unsigned long long hash, unsigned long long count) {
+    unsigned long long h1 = hash, h2 = mix64(hash) | 1;
+    unsigned long long est = ~0ULL;
+    for (int r = 0; r < depth_; ++r) {
+        unsigned long long& c = cells_[(size_t)r * width_ + (size_t)((h1 + r * h2) % (unsigned long long)width_)];
+        c += count;
+        if (c < est) est = c;
+    }
+    total_ += count;
+    return est;
+}
+
+unsigned long long CountMinSketch::estimate(unsigned long long hash) const {
+    unsigned long long h1 = hash, h2 = mix64(hash) | 1;
+    unsigned long long est = ~0ULL;
+    for (int r = 0; r < depth_; ++r) {
+        unsigned long long c = cells_[(size_t)r * width_ + (size_t)((h1 + r * h2) % (unsigned long long)width_)];
+        if (c < est) est = c;
+    }
+    return est;
+}
+
+unsigned long long CountMinSketch::total() const { return total_; }
+
+double CountMinSketch::epsilon() const { return std::exp(1.0) / width_; }
+
+double CountMinSketch::delta() const { return std::exp(-(double)depth_); }
+
+void CountMinSketch::clear() { std::fill(cells_.begin(), cells_.end(), 0ULL); total_ = 0; }
+
+size_t CountMinSketch::memoryBytes() const { return cells_.size() * sizeof(unsigned long long); }
+
+// ApproximateAttendance
+ApproximateAttendance::ApproximateAttendance()
+    : scoring_(0), grade_(0), ownScoring_(false), ownGrade_(false),
+    distinct_(config_.hllPrecision), counts_(config_.cmWidth, config_.cmDepth), records_(0)
+{
+    scoring_ = new DefaultScoringPolicy(); ownScoring_ = true;
+    grade_ = new ThresholdGradePolicy(); ownGrade_ = true;
+}
+
+ApproximateAttendance::ApproximateAttendance(IScoringPolicy* s, IGradePolicy* g, const ApproximateConfig& config)
+    : scoring_(s), grade_(g), ownScoring_(false), ownGrade_(false), config_(config),
+    distinct_(config.hllPrecision), counts_(config.cmWidth, config.cmDepth), records_(0) {
+}
+
+ApproximateAttendance::~ApproximateAttendance() {
+    if (ownScoring_) delete scoring_;
+    if (ownGrade_)   delete grade_;
+}
+
+void ApproximateAttendance::addRecord(const std::string& name, Weekday day) {
+    ++records_;
+    unsigned long long h = hashName(name);
+    distinct_.add(h);
+
+    // 요일별 상위 후보 갱신
+    unsigned long long est = counts_.add(hashNameDay(h, day), 1);
+    std::vector<HeavyHitter>& top = top_[(int)day];
+    size_t minIdx = 0;
+    bool found = false;
+    for (size_t i = 0; i < top.size(); ++i) {
+        if (top[i].name == name) { top[i].estimate = est; found = true; break; }
+        if (top[i].estimate < top[minIdx].estimate) minIdx = i;
+    }
+    if (!found) {
+        HeavyHitter hh; hh.name = name; hh.estimate = est;
+        if (top.empty()) top.reserve((size_t)config_.topK); // 용량은 topK 그대로 (clear 뒤에도 유지)
+        if ((int)top.size() < config_.topK) top.push_back(hh);
+        else if (!top.empty() && est > top[minIdx].estimate) top[minIdx] = hh;
+    }
+
+    // bottom-k 표본: 해시가 가장 작은 k명만 정확히 집계
+    // (한 번 밀려난 이름은 해시가 기준보다 커서 다시 들어오지 않음)
+    std::map<unsigned long long, SampleEntry>::iterator it = sample_.find(h);
+    if (it == sample_.end()) {
+        if ((int)sample_.size() >= config_.sampleSize && (sample_.empty() || h > sample_.rbegin()->first)) return;
+        SampleEntry e; e.name = name;
+        for (int d = 0; d < 7; ++d) e.dayCount[d] = 0;
+        it = sample_.insert(std::make_pair(h, e)).first;
+        if ((int)sample_.size() > config_.sampleSize) sample_.erase(--sample_.end());
+    }
+    it->second.dayCount[(int)day] += 1;
+}
+
+bool ApproximateAttendance::addRecordLine(const std::string& nameToken, const std::string& dayToken) {
+    Weekday w; if (!parseWeekday(dayToken, w)) return false; addRecord(nameToken, w); return true;
+}
+
+void ApproximateAttendance::loadFromStream(std::istream& in) {
+    std::string name, day; while (in >> name >> day) { addRecordLine(name, day); }
+}
+
+bool ApproximateAttendance::loadFromFile(const std::string& path) {
+    std::ifstream fin(path.c_str()); if (!fin.is_open()) { std::cerr << "Failed to open file: " << path << "\n"; return false; }
+    loadFromStream(fin);
+    return true;
+}
+
+double ApproximateAttendance::estimateDistinctPlayers() const {
+    // 표본이 다 차지 않았다면 모든 플레이어가 표본에 있으므로 정확한 값
+    if ((int)sample_.size() < config_.sampleSize) return (double)sample_.size();
+    return distinct_.estimate();
+}
+
+unsigned long long ApproximateAttendance::estimateCount(const std::string& name, Weekday day) const {
+    return counts_.estimate(hashNameDay(hashName(name), day));
+}
+
+std::vector<HeavyHitter> ApproximateAttendance::topAttendees(Weekday day) const {
+    std::vector<HeavyHitter> out = top_[(int)day];
+    std::sort(out.begin(), out.end(), greaterEstimate);
+    return out;
+}
+
+std::vector<GradeEstimate> ApproximateAttendance::estimateGradeBands() const {
+    std::vector<GradeEstimate> out;
+    if (sample_.empty()) return out;
+
+    std::vector<int> hits;
+    for (std::map<unsigned long long, SampleEntry>::const_iterator it = sample_.begin(); it != sample_.end(); ++it) {
+        PlayerStat p;
+        for (int d = 0; d < 7; ++d) {
+            p.dayCount[d] = it->second.dayCount[d];
+            p.basePoints += scoring_->basePoint((Weekday)d) * p.dayCount[d];
+        }
+        p.bonusPoints = scoring_->bonusPoints(p);
+        p.totalPoints = p.basePoints + p.bonusPoints;
+        std::string g = grade_->decide(p.totalPoints);
+
+        size_t k = 0;
+        while (k < out.size() && out[k].gradeName != g) ++k;
+        if (k == out.size()) { GradeEstimate ge; ge.gradeName = g; ge.players = 0; out.push_back(ge); hits.push_back(0); }
+        ++hits[k];
+    }
+
+    double scale = estimateDistinctPlayers() / (double)sample_.size();
+    for (size_t k = 0; k < out.size(); ++k) out[k].players = hits[k] * scale;
+    return out;
+}
+
+unsigned long long ApproximateAttendance::recordCount() const { return records_; }
+
+double ApproximateAttendance::countErrorBound() const { return counts_.epsilon() * (double)counts_.total(); }
+
+size_t ApproximateAttendance::memoryBytes() const {
+    // 실제로 들고 있는 상태: 스케치 + 표본 노드와 이름 버퍼 + 요일별 후보와 이름 버퍼
+    size_t bytes = distinct_.memoryBytes() + counts_.memoryBytes();
+    for (std::map<unsigned long long, SampleEntry>::const_iterator it = sample_.begin(); it != sample_.end(); ++it) {
+        bytes += kMapNodeOverhead + sizeof(*it) + it->second.name.capacity() + 1;
+    }
+    for (int d = 0; d < 7; ++d) {
+        bytes += top_[d].capacity() * sizeof(HeavyHitter);
+        for (size_t i = 0; i < top_[d].size(); ++i) bytes += top_[d][i].name.capacity() + 1;
+    }
+    return bytes;
+}
+
+size_t ApproximateAttendance::memoryLimit(size_t maxNameBytes) const {
+    size_t name = nameCapacityLimit(maxNameBytes);
+    size_t bytes = distinct_.memoryBytes() + counts_.memoryBytes();
+    bytes += (size_t)config_.sampleSize * (kMapNodeOverhead + sizeof(std::pair<const unsigned long long, SampleEntry>) + name);
+    bytes += (size_t)7 * config_.topK * (sizeof(HeavyHitter) + name);
+    return bytes;
+}
+
+void ApproximateAttendance::clear() {
+    distinct_.clear();
+    counts_.clear();
+    for (int d = 0; d < 7; ++d) top_[d].clear();
+    sample_.clear();
+    records_ = 0;
+}
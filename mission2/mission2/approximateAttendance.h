@@ -0,0 +1,113 @@
+﻿#pragma once
+
+#include "attendance.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <iostream>
+
+// 서로 다른 원소 수 추정 (표준 오차 약 1.04 / sqrt(2^precision))
+class HyperLogLog {
+public:
+    explicit HyperLogLog(int precision = 12); // 4..16
+    void add(unsigned long long hash);
+    double estimate() const;
+    void merge(const HyperLogLog& other); // precision이 같아야 함
+    void clear();
+    size_t memoryBytes() const;
+private:
+    int p_;
+    std::vector<unsigned char> regs_;
+};
+
+// 빈도 추정: 항상 실제 이상, 확률 1 - delta로 오차 <= epsilon * total
+class CountMinSketch {
+public:
+    CountMinSketch(int width, int depth); // epsilon = e / width, delta = exp(-depth)
+    unsigned long long add(unsigned long long hash, unsigned long long count); // 갱신 후 추정치
+    unsigned long long estimate(unsigned long long hash) const;
+    unsigned long long total() const;
+    double epsilon() const;
+    double delta() const;
+    void clear();
+    size_t memoryBytes() const;
+private:
+    int width_, depth_;
+    unsigned long long total_;
+    std::vector<unsigned long long> cells_;
+};
+
+struct ApproximateConfig {
+    int hllPrecision;  // 12 -> 4096 레지스터
+    int cmWidth;       // 2048
+    int cmDepth;       // 5
+    int topK;          // 요일별 상위 후보 수 10
+    int sampleSize;    // 등급 추정용 이름 표본 1024
+
+    ApproximateConfig() : hllPrecision(12), cmWidth(2048), cmDepth(5), topK(10), sampleSize(1024) {}
+};
+
+struct HeavyHitter {
+    std::string name;
+    unsigned long long estimate;
+};
+
+struct GradeEstimate {
+    std::string gradeName;
+    double players;
+};
+
+// 근사 모드: 플레이어별 상태 없이 고정 메모리로 대용량 스트림 요약
+//  - 서로 다른 플레이어 수: HyperLogLog
+//  - 요일별 최다 출석자: Count-Min + 요일별 상위 K 후보
+//  - 등급별 인원: 이름 해시 하위 k개 표본(bottom-k)을 정확히 집계해 비율 * 전체 추정치
+class ApproximateAttendance {
+public:
+    ApproximateAttendance(); // 기본 정책 장착
+
+    // 전략 주입 생성자 (소유권은 호출자가 가짐)
+    ApproximateAttendance(IScoringPolicy* scoring, IGradePolicy* grade,
+        const ApproximateConfig& config = ApproximateConfig());
+
+    ~ApproximateAttendance();
+
+    // Input
+    void addRecord(const std::string& name, Weekday day);
+    bool addRecordLine(const std::string& nameToken, const std::string& dayToken);
+    void loadFromStream(std::istream& in);
+    bool loadFromFile(const std::string& path); // 열 수 없으면 false
+
+    // Output
+    double estimateDistinctPlayers() const;
+    unsigned long long estimateCount(const std::string& name, Weekday day) const;
+    std::vector<HeavyHitter> topAttendees(Weekday day) const; // 추정치 내림차순
+    std::vector<GradeEstimate> estimateGradeBands() const;    // 처음 등장한 등급 순
+    unsigned long long recordCount() const;
+    double countErrorBound() const; // epsilon * recordCount
+    size_t memoryBytes() const;                      // 지금 들고 있는 표본/후보/스케치 크기
+    size_t memoryLimit(size_t maxNameBytes) const;   // 이름이 maxNameBytes 이하일 때 memoryBytes 상한 (입력 수와 무관)
+
+    // Utils
+    void clear();
+
+private:
+    struct SampleEntry {
+        std::string name;
+        int dayCount[7];
+    };
+
+    IScoringPolicy* scoring_;
+    IGradePolicy* grade_;
+    bool ownScoring_, ownGrade_;
+    ApproximateConfig config_;
+
+    HyperLogLog distinct_;
+    CountMinSketch counts_;
+    std::vector<HeavyHitter> top_[7];
+    std::map<unsigned long long, SampleEntry> sample_; // 해시 -> 표본
+    unsigned long long records_;
+
+    ApproximateAttendance(const ApproximateAttendance&);
+    ApproximateAttendance& operator=(const ApproximateAttendance&);
+};
@@ -1,7 +1,25 @@
 ﻿#include "attendance.h"
+#include "groupHierarchy.h"
+#include <algorithm>
 #include <fstream>
 #include <cctype>
 
+static unsigned hashName(const std::string& s) {
+    unsigned h = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < s.size(); ++i) { h ^= (unsigned char)s[i]; h *= 16777619u; }
+    return h;
+}
+
+// 재사용하는 저장소 칸을 새 플레이어로 (문자열 버퍼는 유지)
+static void resetStat(PlayerStat& p) {
+    p.id = 0;
+    for (int d = 0; d < 7; ++d) p.dayCount[d] = 0;
+    p.wedCount = p.weekendCount = 0;
+    p.basePoints = p.bonusPoints = p.totalPoints = 0;
+    p.grade.clear();
+    p.eliminationCandidate = false;
+}
+
 static std::string toLowerCopy(const std::string& s) {
     std::string o; o.reserve(s.size());
     for (size_t i = 0; i < s.size(); ++i) { unsigned char c = (unsigned char)s[i]; o.push_back((char)std::tolower(c)); }
@@ -60,7 +78,7 @@ bool NormalNoWedWeekendElimination::isEliminated(const PlayerStat& p) const {
 // AttendanceSystem (Facade)
 AttendanceSystem::AttendanceSystem()
     : scoring_(0), grade_(0), elimination_(0),
-    ownScoring_(false), ownGrade_(false), ownElim_(false)
+    ownScoring_(false), ownGrade_(false), ownElim_(false), generation_(1), live_(0), normalizer_(0), rejected_(0), hierarchy_(0)
 {
     scoring_ = new DefaultScoringPolicy(); ownScoring_ = true;
     grade_ = new ThresholdGradePolicy(); ownGrade_ = true;
@@ -69,7 +87,7 @@ AttendanceSystem::AttendanceSystem()
 
 AttendanceSystem::AttendanceSystem(IScoringPolicy* s, IGradePolicy* g, IEliminationRule* e)
     : scoring_(s), grade_(g), elimination_(e),
-    ownScoring_(false), ownGrade_(false), ownElim_(false) {
+    ownScoring_(false), ownGrade_(false), ownElim_(false), generation_(1), live_(0), normalizer_(0), rejected_(0), hierarchy_(0) {
 }
 
 AttendanceSystem::~AttendanceSystem() {
@@ -78,28 +96,106 @@ AttendanceSystem::~AttendanceSystem() {
     if (ownElim_)    delete elimination_;
 }
 
-int AttendanceSystem::ensurePlayerIndex(const std::string& name) {
-    std::map<std::string, int>::iterator it = indexByName_.find(name);
-    if (it != indexByName_.end()) return it->second;
-    int idx = (int)players_.size();
-    indexByName_.insert(std::make_pair(name, idx));
-    PlayerStat p; p.id = idx + 1; p.name = name; players_.push_back(p);
+int AttendanceSystem::findIndex(const std::string& name, unsigned hash, size_t& slot) const {
+    if (index_.empty()) return -1;
+    size_t mask = index_.size() - 1;
+    for (slot = hash & mask; ; slot = (slot + 1) & mask) {
+        const IndexSlot& s = index_[slot];
+        if (s.generation != generation_) return -1;
+        if (s.hash == hash && keyOf(s.index) == name) return s.index;
+    }
+}
+
+void AttendanceSystem::rehash(size_t capacity) {
+    size_t cap = 16;
+    while (cap < capacity) cap <<= 1;
+    if (cap <= index_.size()) return;
+    IndexSlot empty = { 0, 0, 0 };
+    index_.assign(cap, empty);
+    generation_ = 1;
+    for (size_t i = 0; i < live_; ++i) {
+        unsigned h = hashName(keyOf(i));
+        size_t slot = h & (cap - 1);
+        while (index_[slot].generation == generation_) slot = (slot + 1) & (cap - 1);
+        IndexSlot s = { generation_, h, (int)i };
+        index_[slot] = s;
+    }
+}
+
+const std::string& AttendanceSystem::keyOf(size_t index) const {
+    return normalizer_ ? keys_[index] : players_[index].name;
+}
+
+int AttendanceSystem::ensurePlayerIndex(const std::string& name, size_t records) {
+    const std::string* key = &name;
+    if (normalizer_) {
+        if (!normalizer_->normalize(name, keyBuf_)) { rejected_ += records; return -1; }
+        key = &keyBuf_;
+    }
+    unsigned h = hashName(*key);
+    size_t slot = 0;
+    int found = findIndex(*key, h, slot);
+    if (found >= 0) return found;
+
+    if ((live_ + 1) * 2 > index_.size()) { // 적재율 1/2 이하 유지
+        rehash((live_ + 1) * 2);
+        findIndex(*key, h, slot);
+    }
+    int idx = (int)live_;
+    IndexSlot s = { generation_, h, idx };
+    index_[slot] = s;
+
+    if (normalizer_) {
+        if (live_ == keys_.size()) keys_.push_back(std::string());
+        keys_[live_].assign(*key); // 지난 배치의 버퍼 재사용
+    }
+    if (live_ == players_.size()) players_.push_back(PlayerStat());
+    PlayerStat& p = players_[live_];
+    resetStat(p);
+    p.id = idx + 1;
+    p.name.assign(name);
+    ++live_;
     return idx;
 }
 
-void AttendanceSystem::addRecord(const std::string& name, Weekday day) {
-    int idx = ensurePlayerIndex(name);
+int AttendanceSystem::addRecord(const std::string& name, Weekday day) {
+    int idx = ensurePlayerIndex(name, 1);
+    if (idx < 0) return -1;
     PlayerStat& p = players_[idx];
     p.dayCount[(int)day] += 1;
     p.basePoints += scoring_->basePoint(day);
+    return idx;
+}
+
+void AttendanceSystem::addRecords(const std::string& name, Weekday day, int count) {
+    int idx = ensurePlayerIndex(name, count > 0 ? (size_t)count : 0);
+    if (idx < 0 || count <= 0) return;
+    PlayerStat& p = players_[idx];
+    p.dayCount[(int)day] += count;
+    p.basePoints += scoring_->basePoint(day) * count;
+}
+
+int AttendanceSystem::addDayCounts(const std::string& name, const int dayCount[7]) {
+    size_t records = 0;
+    for (int d = 0; d < 7; ++d) if (dayCount[d] > 0) records += (size_t)dayCount[d];
+    int idx = ensurePlayerIndex(name, records); // 거부되면 합친 기록 수만큼 셈 (한 건씩 넣은 것과 같게)
+    if (idx < 0) return -1;
+    PlayerStat& p = players_[idx];
+    for (int d = 0; d < 7; ++d) {
+        if (dayCount[d] <= 0) continue;
+        p.dayCount[d] += dayCount[d];
+        p.basePoints += scoring_->basePoint((Weekday)d) * dayCount[d];
+    }
+    return idx;
 }
 
 bool AttendanceSystem::addRecordLine(const std::string& nameToken, const std::string& dayToken) {
-    Weekday w; if (!parseWeekday(dayToken, w)) return false; addRecord(nameToken, w); return true;
+    Weekday w; if (!parseWeekday(dayToken, w)) { ++rejected_; return false; }
+    return addRecord(nameToken, w) >= 0;
 }
 
 void AttendanceSystem::loadFromStream(std::istream& in) {
-    std::string name, day; while (in >> name >> day) { addRecordLine(name, day); }
+    while (in >> nameTok_ >> dayTok_) { addRecordLine(nameTok_, dayTok_); } // 토큰 버퍼 재사용
 }
 
 void AttendanceSystem::loadFromFile(const std::string& path) {
@@ -107,8 +203,99 @@ void AttendanceSystem::loadFromFile(const std::string& path) {
     loadFromStream(fin);
 }
 
+// GroupRollup
+int GroupRollup::gradeColumn(const std::string& grade) const {
+    for (size_t i = 0; i < gradeNames.size(); ++i) if (gradeNames[i] == grade) return (int)i;
+    return -1;
+}
+
+void GroupRollup::clear() {
+    gradeNames.clear();
+    members.clear();
+    pointSum.clear();
+    eliminated.clear();
+    gradeCount.clear();
+}
+
+void AttendanceSystem::setHierarchy(const GroupHierarchy* hierarchy) {
+    hierarchy_ = hierarchy;
+    playerGroup_.clear();
+    rollup_.clear();
+    if (!hierarchy_) return;
+    // 그룹 수만큼 한 번만 잡아 두고 compute마다 제자리에서 0으로
+    size_t n = (size_t)hierarchy_->groupCount();
+    rollup_.members.resize(n, 0);
+    rollup_.pointSum.resize(n, 0);
+    rollup_.eliminated.resize(n, 0);
+    for (size_t c = 0; c < spareColumns_.size(); ++c) spareColumns_[c].reserve(n);
+    resolveGroups();
+}
+
+void AttendanceSystem::resolveGroups() {
+    // 조직도 멤버 이름을 정규화 키로 찾아 플레이어 인덱스 -> 그룹 id 벡터를 채움
+    // (같은 키가 되는 멤버가 여럿이면 나중에 지정된 멤버의 그룹)
+    playerGroup_.assign(live_, -1);
+    for (size_t m = 0; m < hierarchy_->memberCount(); ++m) {
+        const std::string* key = &hierarchy_->memberName(m);
+        if (normalizer_) {
+            if (!normalizer_->normalize(*key, keyBuf_)) continue;
+            key = &keyBuf_;
+        }
+        size_t slot = 0;
+        int idx = findIndex(*key, hashName(*key), slot);
+        if (idx >= 0) playerGroup_[idx] = hierarchy_->memberGroup(m);
+    }
+}
+
+void AttendanceSystem::resetRollup() {
+    // 크기는 setHierarchy에서 정해 둠. 등급 열 버퍼는 풀로 돌려 다음 열에서 재사용
+    std::fill(rollup_.members.begin(), rollup_.members.end(), 0);
+    std::fill(rollup_.pointSum.begin(), rollup_.pointSum.end(), 0);
+    std::fill(rollup_.eliminated.begin(), rollup_.eliminated.end(), 0);
+    while (!rollup_.gradeCount.empty()) {
+        spareColumns_.push_back(std::vector<int>());
+        spareColumns_.back().swap(rollup_.gradeCount.back());
+        rollup_.gradeCount.pop_back();
+    }
+    rollup_.gradeNames.clear();
+}
+
+void AttendanceSystem::addToRollup(size_t index, const PlayerStat& p) {
+    int g = playerGroup_[index];
+    if (g < 0) return;
+    int col = rollup_.gradeColumn(p.grade);
+    if (col < 0) {
+        col = (int)rollup_.gradeNames.size();
+        rollup_.gradeNames.push_back(p.grade);
+        rollup_.gradeCount.push_back(std::vector<int>());
+        if (!spareColumns_.empty()) { rollup_.gradeCount.back().swap(spareColumns_.back()); spareColumns_.pop_back(); }
+        rollup_.gradeCount.back().assign(rollup_.members.size(), 0);
+        if (spareColumns_.capacity() < rollup_.gradeCount.size()) spareColumns_.reserve(rollup_.gradeCount.size()); // 다음 resetRollup이 할당 없이 돌려받도록
+    }
+    ++rollup_.members[g];
+    rollup_.pointSum[g] += p.totalPoints;
+    if (p.eliminationCandidate) ++rollup_.eliminated[g];
+    ++rollup_.gradeCount[col][g];
+}
+
+void AttendanceSystem::propagateRollup() {
+    // parent id < child id 이므로 뒤에서부터 한 번이면 모든 조상까지 반영됨
+    for (int g = rollup_.groupCount() - 1; g >= 0; --g) {
+        int parent = hierarchy_->parentOf(g);
+        if (parent < 0) continue;
+        rollup_.members[parent] += rollup_.members[g];
+        rollup_.pointSum[parent] += rollup_.pointSum[g];
+        rollup_.eliminated[parent] += rollup_.eliminated[g];
+        for (size_t c = 0; c < rollup_.gradeCount.size(); ++c) rollup_.gradeCount[c][parent] += rollup_.gradeCount[c][g];
+    }
+}
+
 void AttendanceSystem::compute() {
-    for (size_t i = 0; i < players_.size(); ++i) {
+    if (hierarchy_) {
+        if (playerGroup_.size() != live_) resolveGroups(); // setHierarchy 뒤에 플레이어가 늘었거나 clear됨
+        resetRollup();
+    }
+    for (size_t i = 0; i < live_; ++i) {
         PlayerStat& p = players_[i];
         p.wedCount = p.dayCount[(int)Wed];
         p.weekendCount = p.dayCount[(int)Sat] + p.dayCount[(int)Sun];
@@ -116,20 +303,68 @@ void AttendanceSystem::compute() {
         p.totalPoints = p.basePoints + p.bonusPoints;
         p.grade = grade_->decide(p.totalPoints);
         p.eliminationCandidate = elimination_->isEliminated(p);
+        if (hierarchy_) addToRollup(i, p);
     }
+    if (hierarchy_) propagateRollup();
+}
+PlayerList AttendanceSystem::players() const {
+    return PlayerList(players_.empty() ? 0 : &players_[0], live_, players_.capacity());
+}
+
+const GroupRollup& AttendanceSystem::rollup() const { return rollup_; }
+
+int AttendanceSystem::indexOf(const std::string& name) const {
+    size_t slot = 0;
+    if (!normalizer_) return findIndex(name, hashName(name), slot);
+    std::string key;
+    if (!normalizer_->normalize(name, key)) return -1;
+    return findIndex(key, hashName(key), slot);
+}
+
+size_t AttendanceSystem::rejectedCount() const { return rejected_; }
+
+void AttendanceSystem::addRejected(size_t records) { rejected_ += records; }
+
+void AttendanceSystem::setNameNormalizer(const INameNormalizer* normalizer) {
+    clear();
+    normalizer_ = normalizer;
 }
-const std::vector<PlayerStat>& AttendanceSystem::players() const { return players_; }
 
 void AttendanceSystem::printSummary(std::ostream& os) const {
-    for (size_t i = 0; i < players_.size(); ++i) {
+    for (size_t i = 0; i < live_; ++i) {
         const PlayerStat& p = players_[i];
         os << "NAME : " << p.name << ", POINT : " << p.totalPoints << ", GRADE : " << p.grade << "\n";
     }
     os << "\nRemoved player\n==============\n";
-    for (size_t i = 0; i < players_.size(); ++i) {
+    for (size_t i = 0; i < live_; ++i) {
         const PlayerStat& p = players_[i];
         if (p.eliminationCandidate) os << p.name << "\n";
     }
 }
 
-void AttendanceSystem::clear() { indexByName_.clear(); players_.clear(); }
+void AttendanceSystem::printRollup(std::ostream& os) const {
+    if (!hierarchy_) return;
+    for (int g = 0; g < rollup_.groupCount(); ++g) {
+        os << "GROUP : " << hierarchy_->groupName(g) << ", MEMBERS : " << rollup_.members[g] << ", POINT : " << rollup_.pointSum[g];
+        for (size_t c = 0; c < rollup_.gradeNames.size(); ++c) os << ", " << rollup_.gradeNames[c] << " : " << rollup_.gradeCount[c][g];
+        os << ", REMOVED : " << rollup_.eliminated[g] << "\n";
+    }
+}
+
+void AttendanceSystem::clear() {
+    // 저장소와 이름 버퍼는 그대로 두고 다음 배치가 앞에서부터 덮어씀
+    live_ = 0;
+    rejected_ = 0;
+    playerGroup_.clear();
+    if (++generation_ == 0) { // 세대 값이 한 바퀴 돌면 실제로 비움
+        IndexSlot empty = { 0, 0, 0 };
+        std::fill(index_.begin(), index_.end(), empty);
+        generation_ = 1;
+    }
+}
+
+void AttendanceSystem::reserve(size_t expectedPlayers) {
+    players_.reserve(expectedPlayers);
+    if (normalizer_) keys_.reserve(expectedPlayers);
+    rehash(expectedPlayers * 2);
+}
@@ -1,6 +1,5 @@
 ﻿#pragma once
 
-#include <map>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -10,6 +9,7 @@ enum Weekday { Mon = 0, Tue, Wed, Thu, Fri, Sat, Sun };
 bool parseWeekday(const std::string& s, Weekday& out);
 
 struct PlayerStat;
+class GroupHierarchy;
 
 // Strategy Interfaces
 struct IScoringPolicy {
@@ -28,6 +28,12 @@ struct IEliminationRule {
     virtual bool isEliminated(const PlayerStat& p) const = 0;
 };
 
+// 이름 -> 인덱스 키 (표시용 이름은 처음 본 그대로 유지). 받아들일 수 없는 이름이면 false
+struct INameNormalizer {
+    virtual ~INameNormalizer() {}
+    virtual bool normalize(const std::string& name, std::string& key) const = 0;
+};
+
 struct GradeBand {
     std::string gradeName;
     int minScore;
@@ -77,6 +83,42 @@ struct PlayerStat {
     }
 };
 
+// 플레이어 목록 읽기 전용 뷰 (인덱스 = ID - 1). 저장소는 clear 뒤에도 재사용되므로
+// 뷰와 원소 참조는 다음 기록 추가/clear 전까지만 유효
+class PlayerList {
+public:
+    typedef const PlayerStat* const_iterator;
+
+    PlayerList(const PlayerStat* data, size_t size, size_t capacity) : data_(data), size_(size), capacity_(capacity) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; } // 다시 할당하지 않고 담을 수 있는 인원
+    const PlayerStat& operator[](size_t i) const { return data_[i]; }
+    const PlayerStat& front() const { return data_[0]; }
+    const PlayerStat& back() const { return data_[size_ - 1]; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+private:
+    const PlayerStat* data_;
+    size_t size_, capacity_;
+};
+
+// 그룹(팀/부서)별 집계: 열 단위 배열, 인덱스 = GroupHierarchy 그룹 id
+// 하위 그룹 멤버를 포함한 합계 (소속 없는 플레이어는 제외)
+struct GroupRollup {
+    std::vector<std::string>        gradeNames;   // 등급 열 (처음 나온 순)
+    std::vector<int>                members;
+    std::vector<long long>          pointSum;
+    std::vector<int>                eliminated;
+    std::vector<std::vector<int> >  gradeCount;   // [등급 열][그룹]
+
+    int groupCount() const { return (int)members.size(); }
+    int gradeColumn(const std::string& grade) const; // 없으면 -1
+    void clear();
+};
+
 // Facade
 class AttendanceSystem {
 public:
@@ -91,20 +133,37 @@ public:
     ~AttendanceSystem();
 
     // Input
-    void addRecord(const std::string& name, Weekday day);
+    int addRecord(const std::string& name, Weekday day);               // 플레이어 인덱스 (거부되면 -1)
+    void addRecords(const std::string& name, Weekday day, int count); // 같은 기록 count회 (집계본 병합용)
+    int addDayCounts(const std::string& name, const int dayCount[7]);   // 요일별 횟수를 한 번에, 플레이어 인덱스 (거부되면 -1)
     bool addRecordLine(const std::string& nameToken, const std::string& dayToken);
-    void loadFromStream(std::istream& in);
-    void loadFromFile(const std::string& path);
+    void addRejected(size_t records);           // 다른 곳(부분 집계본, 체크포인트)에서 이미 거부된 기록 수를 합산
+    void loadFromStream(std::istream& in);      // 준비된 뒤에는 할당 없음 (토큰 버퍼 재사용)
+    void loadFromFile(const std::string& path); // 파일 스트림을 열 때마다 할당이 있음
+
+    // 이름 정규화 (소유권은 호출자가 가짐, 0이면 원래 바이트 그대로). 지정하면 기존 기록은 비움
+    void setNameNormalizer(const INameNormalizer* normalizer);
+
+    // 조직도를 지정하면 compute()가 같은 패스에서 그룹별 집계도 채움 (소유권은 호출자가 가짐, 0이면 해제)
+    // 멤버 이름은 플레이어와 같은 정규화 키로 맞춤. 소속은 여기서(그 뒤 플레이어가 늘었으면 다음 compute에서)
+    // 플레이어 인덱스별 벡터로 한 번 풀어 두므로 조직도를 바꾼 뒤에는 다시 호출해야 함
+    void setHierarchy(const GroupHierarchy* hierarchy);
 
     // Compute
     void compute();
 
     // Output
-    const std::vector<PlayerStat>& players() const;
+    PlayerList players() const;
+    int indexOf(const std::string& name) const; // 없으면 -1
+    size_t rejectedCount() const;               // 거부된 기록 수 (잘못된 요일, 정규화 실패한 이름). 이름별이 아니라 기록별
     void printSummary(std::ostream& os) const;
+    const GroupRollup& rollup() const;         // setHierarchy 후 compute() 결과
+    void printRollup(std::ostream& os) const;
 
     // Utils
-    void clear();
+    // clear/reserve로 준비하면 최대 인원 이하의 배치는 addRecord/loadFromStream/compute에서 할당하지 않음
+    void clear();                      // O(1): 플레이어/키 저장소와 이름 버퍼는 그대로 두고 살아 있는 수만 0으로
+    void reserve(size_t expectedPlayers); // 정규화를 쓰면 setNameNormalizer 뒤에 호출 (키 버퍼까지 예약)
 
 private:
     IScoringPolicy* scoring_;
@@ -113,10 +172,38 @@ private:
 
     bool ownScoring_, ownGrade_, ownElim_;
 
-    std::map<std::string, int> indexByName_;
-    std::vector<PlayerStat>   players_;
-
-    int ensurePlayerIndex(const std::string& name);
+    // 이름 인덱스: 개방 주소법 해시 테이블. 세대(generation)가 다른 슬롯은 빈 칸으로 보므로
+    // clear()는 세대 값만 올리면 됨 (O(1), 노드 할당 없음)
+    struct IndexSlot {
+        unsigned generation;
+        unsigned hash;
+        int index;
+    };
+
+    std::vector<IndexSlot>    index_;     // 크기는 2의 거듭제곱
+    unsigned                  generation_;
+    std::vector<PlayerStat>   players_;   // 앞의 live_개만 유효, 나머지는 재사용할 저장소 (이름 버퍼 유지)
+    size_t                    live_;
+
+    const INameNormalizer*    normalizer_;
+    std::vector<std::string>  keys_;      // 정규화 키 (normalizer_가 있을 때만, players_와 같은 순서, 앞의 live_개만 유효)
+    std::string               keyBuf_;
+    std::string               nameTok_, dayTok_; // loadFromStream 토큰 버퍼
+    size_t                    rejected_;
+
+    const GroupHierarchy*     hierarchy_;
+    std::vector<int>          playerGroup_; // 플레이어 인덱스 -> 그룹 id (resolveGroups에서 채움)
+    GroupRollup               rollup_;
+    std::vector<std::vector<int> > spareColumns_; // 지난 compute의 등급 열 버퍼 (재사용)
+
+    int ensurePlayerIndex(const std::string& name, size_t records); // 거부된 이름이면 records만큼 세고 -1
+    const std::string& keyOf(size_t index) const;
+    int findIndex(const std::string& name, unsigned hash, size_t& slot) const;
+    void rehash(size_t capacity);
+    void resolveGroups();
+    void resetRollup();
+    void addToRollup(size_t index, const PlayerStat& p);
+    void propagateRollup();
 
     AttendanceSystem(const AttendanceSystem&);
     AttendanceSystem& operator=(const AttendanceSystem&);
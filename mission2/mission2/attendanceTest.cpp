@@ -1,8 +1,29 @@
 ﻿#include "attendance.h"
 #include "policyFactory.h"
+#include "partialAggregate.h"
+#include "externalAggregation.h"
+#include "checkpointLoader.h"
+#include "approximateAttendance.h"
+#include "multiFileLoader.h"
+#include "batchScheduler.h"
+#include "compressedInput.h"
+#include "groupHierarchy.h"
+#include "resultExport.h"
+#include "nameNormalizer.h"
 #include <gtest/gtest.h>
 #include <sstream>
+#include <iomanip>
 #include <fstream>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <cstring>
+#ifdef ATTENDANCE_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef ATTENDANCE_WITH_ZSTD
+#include <zstd.h>
+#endif
 
 #if _ENABLE_GTEST
 
@@ -27,7 +48,7 @@ TEST(AttendanceSystemTest, IdAssignmentOrder) {
     sys.addRecord("Alice", Wed);    // id = 1
     sys.compute();
 
-    const std::vector<PlayerStat>& ps = sys.players();
+    const PlayerList ps = sys.players();
     ASSERT_EQ(2u, ps.size());
     EXPECT_EQ(1, ps[0].id);
     EXPECT_EQ("Alice", ps[0].name);
@@ -58,7 +79,7 @@ TEST(AttendanceSystemTest, BaseAndBonus) {
     sys.addRecord("Carol", Mon);
 
     sys.compute();
-    const std::vector<PlayerStat>& ps = sys.players();
+    const PlayerList ps = sys.players();
     ASSERT_EQ(3u, ps.size());
 
     // Alice
@@ -89,7 +110,7 @@ TEST(AttendanceSystemTest, GradeDecisions) {
     for (int i = 0; i < 10; ++i) sys.addRecord("Normalo", Mon); // 10점
 
     sys.compute();
-    const std::vector<PlayerStat>& ps = sys.players();
+    const PlayerList ps = sys.players();
     ASSERT_EQ(3u, ps.size());
 
     EXPECT_EQ("GOLD", ps[0].grade);
@@ -116,7 +137,7 @@ TEST(AttendanceSystemTest, EliminationCandidateRule) {
     sys.addRecord("KeepWeekend", Sat);
 
     sys.compute();
-    const std::vector<PlayerStat>& ps = sys.players();
+    const PlayerList ps = sys.players();
     ASSERT_EQ(3u, ps.size());
 
     EXPECT_EQ("Eli", ps[0].name);
@@ -174,7 +195,7 @@ TEST(AttendanceSystemTest, LoadFromStream) {
     sys.loadFromStream(ss);
     sys.compute();
 
-    const std::vector<PlayerStat>& ps = sys.players();
+    const PlayerList ps = sys.players();
     ASSERT_EQ(3u, ps.size()); // BadName 무시로 3명만
 
     // Alice: Wed(3) + Sat(2) = 5점
@@ -234,7 +255,7 @@ TEST(LoadFileTest, LoadFromFileAndPrintSummary) {
     sys.loadFromFile(tmp);
     sys.compute();
 
-    const std::vector<PlayerStat>& ps = sys.players();
+    const PlayerList ps = sys.players();
     ASSERT_EQ(2u, ps.size());
     EXPECT_EQ("Umar", ps[0].name);
     EXPECT_EQ("Daisy", ps[1].name);
@@ -255,4 +276,1390 @@ TEST(LoadFileTest, LoadFromFileNotFoundGraceful) {
     EXPECT_TRUE(sys.players().empty());
 }
 
+// 부분 집계본 병합 테스트
+static const char* kShardNames[] = { "Umar", "Daisy", "Alice", "Xena", "Ian", "Hannah", "Bob", "Zane" };
+static const char* kShardDays[] = { "monday", "tuesday", "wednesday", "thursday", "friday", "saturday", "sunday" };
+
+static std::string makeShardLog(int from, int to) {
+    std::ostringstream oss;
+    for (int i = from; i < to; ++i) oss << kShardNames[(i * 7 + i / 3) % 8] << " " << kShardDays[(i * 5 + 1) % 7] << "\n";
+    return oss.str();
+}
+
+static std::string summaryOf(AttendanceSystem& sys) {
+    sys.compute();
+    std::ostringstream oss;
+    sys.printSummary(oss);
+    return oss.str();
+}
+
+static PartialAggregate shardPartial(int shard, int from, int to) {
+    std::stringstream ss(makeShardLog(from, to));
+    AttendanceSystem sys;
+    sys.loadFromStream(ss);
+    return PartialAggregate::fromSystem(sys, (unsigned long long)shard << 32);
+}
+
+TEST(PartialAggregateTest, MergeMatchesSingleRun) {
+    std::stringstream all(makeShardLog(0, 300));
+    AttendanceSystem whole;
+    whole.loadFromStream(all);
+    std::string expected = summaryOf(whole);
+
+    PartialAggregate a = shardPartial(0, 0, 40);
+    PartialAggregate b = shardPartial(1, 40, 170);
+    PartialAggregate c = shardPartial(2, 170, 300);
+
+    // (a + b) + c == a + (c + b)
+    PartialAggregate left = a; left.merge(b); left.merge(c);
+    PartialAggregate right = c; right.merge(b);
+    PartialAggregate right2 = a; right2.merge(right);
+
+    AttendanceSystem s1, s2;
+    left.applyTo(s1);
+    right2.applyTo(s2);
+    EXPECT_EQ(expected, summaryOf(s1));
+    EXPECT_EQ(expected, summaryOf(s2));
+}
+
+TEST(PartialAggregateTest, RecordOffsetKeyBaseKeepsSequentialIds) {
+    // 뒤 사이트에서 처음 나온 이름이 이름 순으로는 앞서도 ID는 등장 순서를 따라야 함
+    const std::string siteA = "Zed monday\nYuri tuesday\n", siteB = "Amy monday\nZed friday\n";
+    std::stringstream all(siteA + siteB), inA(siteA), inB(siteB);
+    AttendanceSystem whole, a, b;
+    whole.loadFromStream(all);
+    a.loadFromStream(inA);
+    b.loadFromStream(inB);
+
+    PartialAggregate merged = PartialAggregate::fromSystem(a, 0);
+    merged.merge(PartialAggregate::fromSystem(b, 2)); // siteA 기록 수
+    AttendanceSystem sys;
+    merged.applyTo(sys);
+    ASSERT_EQ(3u, sys.players().size());
+    EXPECT_EQ("Amy", sys.players()[2].name);
+    EXPECT_EQ(summaryOf(whole), summaryOf(sys));
+}
+
+TEST(PartialAggregateTest, SaveLoadRoundTrip) {
+    PartialAggregate a = shardPartial(0, 0, 100);
+    std::stringstream ss;
+    a.save(ss);
+
+    PartialAggregate b;
+    ASSERT_TRUE(b.load(ss));
+    ASSERT_EQ(a.size(), b.size());
+
+    AttendanceSystem s1, s2;
+    a.applyTo(s1);
+    b.applyTo(s2);
+    EXPECT_EQ(summaryOf(s1), summaryOf(s2));
+}
+
+TEST(PartialAggregateTest, KWayMergeFiles) {
+    std::stringstream all(makeShardLog(0, 300));
+    AttendanceSystem whole;
+    whole.loadFromStream(all);
+    std::string expected = summaryOf(whole);
+
+    std::vector<std::string> paths;
+    paths.push_back("ut_part0.txt"); paths.push_back("ut_part1.txt"); paths.push_back("ut_part2.txt");
+    ASSERT_TRUE(shardPartial(0, 0, 90).saveToFile(paths[0]));
+    ASSERT_TRUE(shardPartial(1, 90, 200).saveToFile(paths[1]));
+    ASSERT_TRUE(shardPartial(2, 200, 300).saveToFile(paths[2]));
+
+    // 트리 병합: (p0 + p1) -> p01, p01 + p2
+    {
+        std::ofstream fout("ut_part01.txt");
+        std::vector<std::string> first(paths.begin(), paths.begin() + 2);
+        ASSERT_TRUE(mergePartialFiles(first, fout));
+    }
+    std::vector<std::string> second;
+    second.push_back("ut_part01.txt"); second.push_back(paths[2]);
+    PartialAggregate merged;
+    ASSERT_TRUE(mergePartialFiles(second, merged));
+
+    AttendanceSystem sys;
+    merged.applyTo(sys);
+    EXPECT_EQ(expected, summaryOf(sys));
+
+    for (size_t i = 0; i < paths.size(); ++i) std::remove(paths[i].c_str());
+    std::remove("ut_part01.txt");
+}
+
+TEST(PartialAggregateTest, RejectsInvalidFiles) {
+    std::stringstream bad("NOTPART 1\n");
+    PartialAggregate a;
+    EXPECT_FALSE(a.load(bad));
+
+    // 이름 정렬이 깨진 파일은 병합 불가
+    std::stringstream unsorted("ATTPART 1\n0 Zed 1 0 0 0 0 0 0\n1 Amy 1 0 0 0 0 0 0\n");
+    PartialAggregate b;
+    EXPECT_FALSE(b.load(unsorted));
+
+    std::vector<std::string> paths;
+    paths.push_back("__no_such_part__.txt");
+    PartialAggregate c;
+    EXPECT_FALSE(mergePartialFiles(paths, c));
+}
+
+// 외부 메모리 집계 테스트
+static std::string makeManyPlayersLog(int players, int records) {
+    std::ostringstream oss;
+    for (int i = 0; i < records; ++i) {
+        int who = (int)(((unsigned)i * 2654435761u) % (unsigned)players);
+        oss << "P" << who << " " << kShardDays[(i * 3 + who) % 7] << "\n";
+    }
+    return oss.str();
+}
+
+TEST(ExternalAggregationTest, SpillMatchesInMemory) {
+    const std::string log = makeManyPlayersLog(3000, 20000);
+    std::stringstream in1(log), in2(log);
+
+    AttendanceSystem exact;
+    exact.loadFromStream(in1);
+    std::string expected = summaryOf(exact);
+
+    ExternalAttendanceAggregator ext;
+    ext.setMemoryBudget(16 * 1024); // 수십 명만 들어가는 예산
+    ext.setPartitionCount(7);
+    ext.setTempPrefix("ut_spill");
+    ext.loadFromStream(in2);
+    ASSERT_TRUE(ext.compute());
+    EXPECT_TRUE(ext.spilled());
+    EXPECT_EQ(exact.players().size(), ext.playerCount());
+
+    std::ostringstream oss;
+    ASSERT_TRUE(ext.printSummary(oss));
+    EXPECT_EQ(expected, oss.str());
+}
+
+TEST(ExternalAggregationTest, OversizedPartitionsAreSplitToBudget) {
+    const std::string log = makeManyPlayersLog(5000, 15000);
+    std::stringstream in1(log), in2(log);
+    AttendanceSystem exact;
+    exact.loadFromStream(in1);
+    std::string expected = summaryOf(exact);
+
+    // 첫 파티션 2개로는 한 파티션에 수천 명 -> 예산(십여 명)에 맞게 다시 나눠야 함
+    const size_t budget = 4 * 1024;
+    ExternalAttendanceAggregator ext;
+    ext.setMemoryBudget(budget);
+    ext.setPartitionCount(2);
+    ext.setTempPrefix("ut_tiny");
+    ext.loadFromStream(in2);
+    ASSERT_TRUE(ext.compute());
+    EXPECT_GT(ext.peakResidentBytes(), 0u);
+    EXPECT_LE(ext.peakResidentBytes(), budget);
+    EXPECT_EQ(exact.players().size(), ext.playerCount());
+
+    std::ostringstream oss;
+    ASSERT_TRUE(ext.printSummary(oss));
+    EXPECT_EQ(expected, oss.str());
+}
+
+TEST(ExternalAggregationTest, NoSpillWithinBudget) {
+    std::stringstream in1(makeShardLog(0, 300)), in2(makeShardLog(0, 300));
+    AttendanceSystem exact;
+    exact.loadFromStream(in1);
+    std::string expected = summaryOf(exact);
+
+    ExternalAttendanceAggregator ext;
+    EXPECT_FALSE(ext.printSummary(std::cout)); // compute 전에는 출력 불가
+    EXPECT_FALSE(ext.loadFromFile("__no_such_file__.txt"));
+    ext.loadFromStream(in2);
+    ASSERT_TRUE(ext.compute());
+    EXPECT_FALSE(ext.spilled());
+
+    std::ostringstream oss;
+    ASSERT_TRUE(ext.printSummary(oss));
+    EXPECT_EQ(expected, oss.str());
+
+    ext.clear();
+    EXPECT_EQ(0u, ext.playerCount());
+}
+
+// 체크포인트 재시작 테스트
+// killAt 바이트를 넘겨 읽으려는 순간 프로세스를 종료시키는 입력 버퍼
+class KillingStreamBuf : public std::streambuf {
+public:
+    KillingStreamBuf(const std::string& data, size_t killAt) : data_(data), killAt_(killAt) { window(0); }
+
+protected:
+    virtual int_type underflow() {
+        size_t pos = (size_t)(gptr() - eback());
+        if (pos >= data_.size()) return traits_type::eof();
+        if (pos >= killAt_) std::_Exit(3);
+        window(pos);
+        return traits_type::to_int_type(*gptr());
+    }
+    virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) {
+        size_t base = (dir == std::ios_base::beg) ? 0 : (dir == std::ios_base::end) ? data_.size() : (size_t)(gptr() - eback());
+        return seekpos(pos_type((off_type)base + off), std::ios_base::in);
+    }
+    virtual pos_type seekpos(pos_type sp, std::ios_base::openmode) {
+        size_t pos = (size_t)(off_type)sp;
+        if (pos > data_.size()) return pos_type(off_type(-1));
+        window(pos);
+        return sp;
+    }
+
+private:
+    std::string data_;
+    size_t killAt_;
+
+    void window(size_t pos) { // 64바이트씩만 노출
+        char* base = &data_[0];
+        size_t end = pos + 64 < data_.size() ? pos + 64 : data_.size();
+        setg(base, base + pos, base + end);
+    }
+};
+
+static void loadUntilKilled(const std::string& log, size_t killAt, const std::string& ckpt) {
+    KillingStreamBuf buf(log, killAt);
+    std::istream in(&buf);
+    AttendanceSystem sys;
+    CheckpointedLoader loader(sys, ckpt);
+    loader.setInterval(40);
+    loader.loadFromStream(in);
+    std::_Exit(3);
+}
+
+TEST(CheckpointTest, ResumeAfterRandomKills) {
+    const std::string log = makeManyPlayersLog(500, 4000);
+    const std::string ckpt = "ut_checkpoint.txt";
+    std::remove(ckpt.c_str());
+
+    std::stringstream whole(log);
+    AttendanceSystem exact;
+    exact.loadFromStream(whole);
+    std::string expected = summaryOf(exact);
+
+    unsigned seed = 12345;
+    size_t killAt = 0;
+    for (int round = 0; round < 5; ++round) {
+        seed = seed * 1103515245u + 12345u;
+        killAt += 1 + (seed >> 8) % (log.size() / 6);
+        EXPECT_EXIT(loadUntilKilled(log, killAt, ckpt), ::testing::ExitedWithCode(3), "");
+    }
+
+    std::stringstream rest(log);
+    AttendanceSystem sys;
+    CheckpointedLoader loader(sys, ckpt);
+    loader.setInterval(40);
+    ASSERT_TRUE(loader.loadFromStream(rest));
+    EXPECT_GT(loader.resumedOffset(), 0u);
+    EXPECT_EQ(expected, summaryOf(sys));
+
+    std::remove(ckpt.c_str());
+}
+
+TEST(CheckpointTest, TornCheckpointTailIsIgnored) {
+    const std::string log = makeManyPlayersLog(200, 2000);
+    const std::string ckpt = "ut_checkpoint_torn.txt";
+    const std::string path = "ut_checkpoint_log.txt";
+    std::remove(ckpt.c_str());
+    { std::ofstream fout(path.c_str(), std::ios::binary); fout << log; }
+
+    std::stringstream whole(log);
+    AttendanceSystem exact;
+    exact.loadFromStream(whole);
+    std::string expected = summaryOf(exact);
+
+    AttendanceSystem first;
+    {
+        CheckpointedLoader loader(first, ckpt);
+        loader.setInterval(25);
+        ASSERT_TRUE(loader.loadFromFile(path));
+    }
+    EXPECT_EQ(expected, summaryOf(first));
+
+    // 체크포인트 파일을 임의 위치에서 자른 뒤 재개
+    std::string data;
+    {
+        std::ifstream fin(ckpt.c_str(), std::ios::binary);
+        std::ostringstream oss; oss << fin.rdbuf(); data = oss.str();
+    }
+    const size_t cuts[] = { data.size() / 3, data.size() / 2 + 7, data.size() - 5 };
+    for (size_t i = 0; i < 3; ++i) {
+        { std::ofstream fout(ckpt.c_str(), std::ios::binary | std::ios::trunc); fout << data.substr(0, cuts[i]); }
+        AttendanceSystem sys;
+        CheckpointedLoader loader(sys, ckpt);
+        loader.setInterval(25);
+        ASSERT_TRUE(loader.loadFromFile(path));
+        EXPECT_GT(loader.resumedOffset(), 0u);
+        EXPECT_EQ(expected, summaryOf(sys));
+    }
+
+    std::remove(ckpt.c_str());
+    std::remove(path.c_str());
+}
+
+TEST(CheckpointTest, ResumesWithNormalizerAndRejectedNames) {
+    // 블록 안에 대소문자 변형과 거부되는 이름이 섞여 있어도 마지막 온전한 블록에서 이어 읽어야 함
+    std::ostringstream oss;
+    for (int i = 0; i < 1200; ++i) {
+        int who = (i * 37) % 90;
+        oss << (i % 3 ? "P" : "p") << who << " " << kShardDays[(i * 3 + who) % 7] << "\n";
+        if (i % 50 == 7) oss << "Bad\x01Name monday\n";
+    }
+    const std::string log = oss.str();
+    const std::string ckpt = "ut_checkpoint_norm.txt";
+    const std::string path = "ut_checkpoint_norm_log.txt";
+    std::remove(ckpt.c_str());
+    { std::ofstream fout(path.c_str(), std::ios::binary); fout << log; }
+
+    DefaultNameNormalizer normalizer;
+    std::stringstream whole(log);
+    AttendanceSystem exact;
+    exact.setNameNormalizer(&normalizer);
+    exact.loadFromStream(whole);
+    std::string expected = summaryOf(exact);
+
+    {
+        AttendanceSystem first;
+        first.setNameNormalizer(&normalizer);
+        CheckpointedLoader loader(first, ckpt);
+        loader.setInterval(30);
+        ASSERT_TRUE(loader.loadFromFile(path));
+    }
+    std::string data;
+    {
+        std::ifstream fin(ckpt.c_str(), std::ios::binary);
+        std::ostringstream all; all << fin.rdbuf(); data = all.str();
+    }
+    { std::ofstream fout(ckpt.c_str(), std::ios::binary | std::ios::trunc); fout << data.substr(0, data.size() - 5); }
+
+    AttendanceSystem sys;
+    sys.setNameNormalizer(&normalizer);
+    CheckpointedLoader loader(sys, ckpt);
+    loader.setInterval(30);
+    ASSERT_TRUE(loader.loadFromFile(path));
+    EXPECT_GT(loader.resumedOffset(), log.size() * 9 / 10);
+    EXPECT_EQ(expected, summaryOf(sys));
+    EXPECT_EQ(24u, exact.rejectedCount());
+    EXPECT_EQ(exact.rejectedCount(), sys.rejectedCount()); // 복구한 블록의 누적 거부 수 포함
+
+    std::remove(ckpt.c_str());
+    std::remove(path.c_str());
+}
+
+TEST(CheckpointTest, RejectsCheckpointOfDifferentInput) {
+    const std::string ckpt = "ut_checkpoint_other.txt";
+    std::remove(ckpt.c_str());
+    std::stringstream a(makeManyPlayersLog(50, 300)), b(makeManyPlayersLog(60, 300));
+    {
+        AttendanceSystem sys;
+        CheckpointedLoader loader(sys, ckpt);
+        ASSERT_TRUE(loader.loadFromStream(a));
+    }
+    AttendanceSystem sys;
+    CheckpointedLoader loader(sys, ckpt);
+    EXPECT_FALSE(loader.loadFromStream(b));
+
+    // 같은 입력이면 끝 위치에서 이어감 (추가로 읽을 것 없음)
+    std::stringstream again(makeManyPlayersLog(50, 300));
+    ASSERT_TRUE(loader.loadFromStream(again));
+    EXPECT_EQ(again.str().size(), loader.resumedOffset());
+    std::remove(ckpt.c_str());
+}
+
+TEST(CheckpointTest, MissingInputFails) {
+    AttendanceSystem sys;
+    CheckpointedLoader loader(sys, "ut_checkpoint_missing.txt");
+    EXPECT_FALSE(loader.loadFromFile("__no_such_file__.txt"));
+
+    // 체크포인트를 쓸 수 없으면 실패로 알림
+    std::stringstream in(makeManyPlayersLog(20, 100));
+    CheckpointedLoader unwritable(sys, "__no_such_dir__/ckpt.txt");
+    EXPECT_FALSE(unwritable.loadFromStream(in));
+}
+
+// 근사 모드 테스트 (정확한 경로와 비교해 오차 범위 검증)
+static std::string makeSkewedLog(int players, int records) {
+    std::ostringstream oss;
+    unsigned seed = 7;
+    for (int i = 0; i < records; ++i) {
+        seed = seed * 1103515245u + 12345u; unsigned a = (seed >> 8) % (unsigned)players;
+        seed = seed * 1103515245u + 12345u; unsigned b = (seed >> 8) % (unsigned)players;
+        seed = seed * 1103515245u + 12345u;
+        unsigned who = (unsigned)((unsigned long long)a * b / players); // 작은 번호일수록 자주 등장
+        oss << "M" << who << " " << kShardDays[(seed >> 8) % 7] << "\n";
+    }
+    return oss.str();
+}
+
+TEST(ApproximateTest, DistinctPlayersWithinHllError) {
+    ApproximateAttendance approx;
+    AttendanceSystem exact;
+    for (int i = 0; i < 50000; ++i) {
+        std::ostringstream name; name << "U" << i;
+        approx.addRecord(name.str(), (Weekday)(i % 7));
+        exact.addRecord(name.str(), (Weekday)(i % 7));
+    }
+    double n = (double)exact.players().size();
+    EXPECT_NEAR(n, approx.estimateDistinctPlayers(), n * 0.05); // 표준 오차 1.6%의 3배 이내
+
+    ApproximateAttendance small;
+    for (int i = 0; i < 300; ++i) { std::ostringstream name; name << "S" << (i % 100); small.addRecord(name.str(), Mon); }
+    EXPECT_DOUBLE_EQ(100.0, small.estimateDistinctPlayers()); // 표본 안에 모두 들어가면 정확
+}
+
+TEST(ApproximateTest, CountMinBoundsAndHeavyHitters) {
+    // 요일마다 확실한 최다 출석자(Top<d>)를 섞음
+    std::ostringstream oss;
+    oss << makeSkewedLog(5000, 100000);
+    for (int i = 0; i < 7 * 500; ++i) oss << "Top" << (i % 7) << " " << kShardDays[i % 7] << "\n";
+    const std::string log = oss.str();
+    std::stringstream in1(log), in2(log);
+    AttendanceSystem exact;
+    exact.loadFromStream(in1);
+    ApproximateAttendance approx;
+    approx.loadFromStream(in2);
+    ASSERT_EQ(100000u + 7 * 500, approx.recordCount());
+
+    // 추정치 >= 실제, 오차가 epsilon * N 을 넘는 비율 <= delta (여유를 두고 1%)
+    const PlayerList ps = exact.players();
+    size_t over = 0, total = 0;
+    for (size_t i = 0; i < ps.size(); ++i) {
+        for (int d = 0; d < 7; ++d) {
+            unsigned long long est = approx.estimateCount(ps[i].name, (Weekday)d);
+            ASSERT_GE(est, (unsigned long long)ps[i].dayCount[d]);
+            if ((double)(est - ps[i].dayCount[d]) > approx.countErrorBound()) ++over;
+            ++total;
+        }
+    }
+    EXPECT_LE(over, total / 100);
+
+    // 요일별 1위는 정확한 경로와 일치
+    for (int d = 0; d < 7; ++d) {
+        std::ostringstream top; top << "Top" << d;
+        size_t best = 0;
+        for (size_t i = 1; i < ps.size(); ++i) if (ps[i].dayCount[d] > ps[best].dayCount[d]) best = i;
+        std::vector<HeavyHitter> hitters = approx.topAttendees((Weekday)d);
+        ASSERT_FALSE(hitters.empty());
+        EXPECT_EQ(top.str(), ps[best].name);
+        EXPECT_EQ(ps[best].name, hitters[0].name);
+        EXPECT_LE((double)(hitters[0].estimate - ps[best].dayCount[d]), approx.countErrorBound());
+    }
+}
+
+TEST(ApproximateTest, GradeBandsNearExact) {
+    const std::string log = makeSkewedLog(20000, 400000);
+    std::stringstream in1(log), in2(log);
+    AttendanceSystem exact;
+    exact.loadFromStream(in1);
+    exact.compute();
+    ApproximateAttendance approx;
+    approx.loadFromStream(in2);
+
+    std::map<std::string, double> truth;
+    const PlayerList ps = exact.players();
+    for (size_t i = 0; i < ps.size(); ++i) truth[ps[i].grade] += 1.0;
+
+    std::vector<GradeEstimate> bands = approx.estimateGradeBands();
+    ASSERT_FALSE(bands.empty());
+    double n = (double)ps.size();
+    for (size_t k = 0; k < bands.size(); ++k) {
+        EXPECT_NEAR(truth[bands[k].gradeName], bands[k].players, n * 0.05) << bands[k].gradeName;
+    }
+
+    // 고정 메모리: 서로 다른 긴 이름이 아무리 많아도 표본/후보 수로 제한됨
+    const size_t nameBytes = 100;
+    EXPECT_LE(approx.memoryBytes(), approx.memoryLimit(nameBytes));
+    for (int i = 0; i < 60000; ++i) {
+        std::ostringstream name;
+        name << std::string(nameBytes - 8, 'x') << std::setw(8) << std::setfill('0') << i;
+        approx.addRecord(name.str(), (Weekday)(i % 7));
+    }
+    const size_t full = approx.memoryBytes();
+    EXPECT_GT(full, (size_t)ApproximateConfig().sampleSize * nameBytes); // 이름 버퍼까지 셈
+    EXPECT_LE(full, approx.memoryLimit(nameBytes));
+    for (int i = 60000; i < 120000; ++i) {
+        std::ostringstream name;
+        name << std::string(nameBytes - 8, 'y') << std::setw(8) << std::setfill('0') << i;
+        approx.addRecord(name.str(), (Weekday)(i % 7));
+    }
+    EXPECT_LE(approx.memoryBytes(), approx.memoryLimit(nameBytes));
+    EXPECT_FALSE(approx.loadFromFile("__no_such_file__.txt"));
+
+    approx.clear();
+    EXPECT_EQ(0u, approx.recordCount());
+    EXPECT_TRUE(approx.estimateGradeBands().empty());
+}
+
+// 다중 파일 병렬 입력 테스트
+static std::string readFileText(const std::string& path) {
+    std::ifstream fin(path.c_str(), std::ios::binary);
+    std::ostringstream oss;
+    oss << fin.rdbuf();
+    return oss.str();
+}
+
+TEST(MultiFileLoaderTest, MatchesSequentialLoad) {
+    std::vector<std::string> paths;
+    AttendanceSystem sequential;
+    for (int f = 0; f < 12; ++f) {
+        std::ostringstream path; path << "ut_site" << (f < 10 ? "0" : "") << f << ".ut_daylog";
+        paths.push_back(path.str());
+        std::ofstream fout(path.str().c_str(), std::ios::binary);
+        fout << makeManyPlayersLog(40 + f * 13, 150 + f * 37);
+        if (f == 3) fout << "Odd monday\r\nBadDay funday Dangling";
+    }
+    for (size_t i = 0; i < paths.size(); ++i) sequential.loadFromFile(paths[i]);
+    std::string expected = summaryOf(sequential);
+
+    AttendanceSystem parallel;
+    MultiFileLoader loader(parallel);
+    loader.setThreadCount(3);
+    ASSERT_TRUE(loader.loadFromFiles(paths));
+    EXPECT_EQ(expected, summaryOf(parallel));
+
+    // 파일 몇 개 크기의 예산: 버퍼에 둔 바이트는 예산 + 가장 큰 파일 이하
+    size_t largest = 0;
+    for (size_t i = 0; i < paths.size(); ++i) largest = std::max(largest, readFileText(paths[i]).size());
+    AttendanceSystem bounded;
+    MultiFileLoader boundedLoader(bounded);
+    boundedLoader.setThreadCount(4);
+    boundedLoader.setMemoryBudget(largest);
+    ASSERT_TRUE(boundedLoader.loadFromFiles(paths));
+    EXPECT_EQ(expected, summaryOf(bounded));
+    EXPECT_GT(boundedLoader.peakBufferedBytes(), 0u);
+    EXPECT_LE(boundedLoader.peakBufferedBytes(), 2 * largest);
+
+    // 디렉터리 입력은 파일명 순
+    AttendanceSystem fromDir;
+    MultiFileLoader dirLoader(fromDir);
+    ASSERT_TRUE(dirLoader.loadFromDirectory(".", ".ut_daylog"));
+    EXPECT_EQ(expected, summaryOf(fromDir));
+
+    for (size_t i = 0; i < paths.size(); ++i) std::remove(paths[i].c_str());
+}
+
+TEST(MultiFileLoaderTest, MissingFilesAreCounted) {
+    std::vector<std::string> paths;
+    paths.push_back("__no_such_file__.txt");
+    AttendanceSystem sys;
+    MultiFileLoader loader(sys);
+    EXPECT_FALSE(loader.loadFromFiles(paths));
+    EXPECT_EQ(1u, loader.failedFiles());
+    EXPECT_TRUE(sys.players().empty());
+    EXPECT_FALSE(loader.loadFromDirectory("__no_such_dir__"));
+}
+
+TEST(MultiFileLoaderTest, ParseRecordsMatchesStreamRules) {
+    const std::string text = "  Amy MONDAY\n\tBob funday\nAmy sunday Cat";
+    PartialAggregate agg;
+    parseRecords(text.data(), text.size(), agg);
+    ASSERT_EQ(1u, agg.size());
+    EXPECT_EQ("Amy", agg.entries()[0].name);
+    EXPECT_EQ(1, agg.entries()[0].dayCount[Mon]);
+    EXPECT_EQ(1, agg.entries()[0].dayCount[Sun]);
+}
+
+// 멀티 테넌트 배치 스케줄러 테스트
+class CountingPolicyFactory : public IPolicyFactory {
+public:
+    CountingPolicyFactory() : created(0) {}
+    virtual PolicyBundle create() { ++created; return DefaultPolicyFactory().create(); }
+    int created;
+};
+
+TEST(BatchSchedulerTest, MatchesSequentialPerTenant) {
+    BatchScheduler batch(3);
+    batch.setChunkBytes(97); // 줄 중간에서 잘리도록 작게
+    std::vector<std::string> expected, files;
+    for (int t = 0; t < 6; ++t) {
+        TenantJob job;
+        std::ostringstream name; name << "tenant" << t;
+        job.name = name.str();
+        job.outputPath = "ut_" + job.name + ".out";
+        AttendanceSystem sequential;
+        for (int f = 0; f < 1 + t % 3; ++f) {
+            std::ostringstream path; path << "ut_" << job.name << "_" << f << ".log";
+            std::ofstream fout(path.str().c_str(), std::ios::binary);
+            fout << makeManyPlayersLog(10 + t * 40, 30 + t * 400 + f * 17);
+            if (t == 2) fout << "Odd monday\r\nBadDay funday\n";
+            fout.close();
+            sequential.loadFromFile(path.str());
+            job.inputs.push_back(path.str());
+            files.push_back(path.str());
+        }
+        expected.push_back(summaryOf(sequential));
+        files.push_back(job.outputPath);
+        batch.addTenant(job);
+    }
+
+    ASSERT_TRUE(batch.run());
+    ASSERT_EQ(6u, batch.results().size());
+    for (int t = 0; t < 6; ++t) {
+        const TenantResult& r = batch.results()[t];
+        EXPECT_TRUE(r.ok);
+        EXPECT_EQ(expected[t], readFileText("ut_" + r.name + ".out")) << r.name;
+    }
+    for (size_t i = 0; i < files.size(); ++i) std::remove(files[i].c_str());
+}
+
+TEST(BatchSchedulerTest, SharesPoliciesAndReportsFailures) {
+    std::ofstream("ut_shared.log") << makeShardLog(0, 200);
+    CountingPolicyFactory factory;
+    BatchScheduler batch(2);
+    const char* outputs[3] = { "ut_shared0.out", "ut_shared1.out", "ut_broken.out" };
+    for (int t = 0; t < 3; ++t) {
+        TenantJob job;
+        job.name = (t == 2) ? "broken" : "shared";
+        job.inputs.push_back(t == 2 ? "__no_such_file__.txt" : "ut_shared.log");
+        job.outputPath = outputs[t];
+        job.factory = &factory;
+        EXPECT_TRUE(batch.addTenant(job));
+    }
+    // 출력 경로가 겹치는 테넌트는 받지 않음
+    TenantJob duplicate;
+    duplicate.name = "duplicate";
+    duplicate.inputs.push_back("ut_shared.log");
+    duplicate.outputPath = outputs[0];
+    EXPECT_FALSE(batch.addTenant(duplicate));
+
+    EXPECT_FALSE(batch.run());
+    ASSERT_EQ(3u, batch.results().size());
+    EXPECT_EQ(1, factory.created);
+    EXPECT_TRUE(batch.results()[0].ok);
+    EXPECT_TRUE(batch.results()[1].ok);
+    EXPECT_FALSE(batch.results()[2].ok);
+    EXPECT_EQ(0u, batch.results()[2].players);
+
+    std::stringstream ss(makeShardLog(0, 200));
+    AttendanceSystem sequential;
+    sequential.loadFromStream(ss);
+    EXPECT_EQ(summaryOf(sequential), readFileText(outputs[0]));
+    EXPECT_EQ(summaryOf(sequential), readFileText(outputs[1]));
+    std::remove("ut_shared.log");
+    for (int t = 0; t < 3; ++t) std::remove(outputs[t]);
+}
+
+struct FanOutTask : public ITask {
+    FanOutTask(int depth, std::atomic<int>* leaves) : depth(depth), leaves(leaves) {}
+    virtual void run(WorkStealingPool& pool) {
+        if (depth == 0) { ++*leaves; return; }
+        for (int i = 0; i < 3; ++i) pool.submit(new FanOutTask(depth - 1, leaves));
+    }
+    int depth;
+    std::atomic<int>* leaves;
+};
+
+TEST(BatchSchedulerTest, PoolWaitsForNestedTasks) {
+    std::atomic<int> leaves(0);
+    WorkStealingPool pool(4);
+    EXPECT_EQ(4, pool.threadCount());
+    pool.submit(new FanOutTask(6, &leaves));
+    pool.submit(new FanOutTask(2, &leaves));
+    pool.wait();
+    EXPECT_EQ(729 + 9, leaves.load());
+    pool.wait(); // 남은 작업이 없으면 바로 반환
+}
+
+// 압축 로그 입력 테스트
+static std::string loadSummary(const std::string& path) {
+    AttendanceSystem sys;
+    sys.loadFromFile(path);
+    return summaryOf(sys);
+}
+
+TEST(CompressedInputTest, CompleteRecordsAcrossAnySplit) {
+    const std::string text = makeManyPlayersLog(30, 60) + "Odd monday\r\nBadDay funday Dangling\nTail sunday";
+    AttendanceSystem whole;
+    std::stringstream ss(text);
+    whole.loadFromStream(ss);
+    const std::string expected = summaryOf(whole);
+
+    for (size_t cut = 0; cut <= text.size(); cut += 7) {
+        AttendanceSystem sys;
+        PartialAggregate agg;
+        size_t used = parseCompleteRecords(text.data(), cut, agg);
+        ASSERT_LE(used, cut);
+        agg.applyTo(sys);
+        agg.clear();
+        parseRecords(text.data() + used, text.size() - used, agg);
+        agg.applyTo(sys);
+        ASSERT_EQ(expected, summaryOf(sys)) << "cut " << cut;
+    }
+}
+
+TEST(CompressedInputTest, PlainTextPassesThrough) {
+    std::ofstream("ut_plain_pass.log", std::ios::binary) << makeManyPlayersLog(80, 1500) << "BadDay funday\n";
+    AttendanceSystem sys;
+    CompressedLoader loader(sys);
+    loader.setBlockBytes(100);
+    ASSERT_TRUE(loader.loadFromFile("ut_plain_pass.log"));
+    EXPECT_EQ(PlainText, loader.lastFormat());
+    EXPECT_EQ(80u, sys.players().size());
+    EXPECT_EQ(loadSummary("ut_plain_pass.log"), summaryOf(sys));
+
+    CompressedStreamBuf buf;
+    ASSERT_TRUE(buf.open("ut_plain_pass.log"));
+    std::istream in(&buf);
+    AttendanceSystem viaStream;
+    viaStream.loadFromStream(in);
+    EXPECT_FALSE(buf.failed());
+    EXPECT_EQ(summaryOf(sys), summaryOf(viaStream));
+
+    EXPECT_FALSE(loader.loadFromFile("__no_such_file__.txt"));
+    std::remove("ut_plain_pass.log");
+}
+
+#ifdef ATTENDANCE_WITH_ZLIB
+static void writeGzipMember(std::ofstream& out, const std::string& text) {
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+    deflateInit2(&zs, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::vector<char> buf(deflateBound(&zs, (uLong)text.size()) + 64);
+    zs.next_in = (Bytef*)text.data(); zs.avail_in = (uInt)text.size();
+    zs.next_out = (Bytef*)&buf[0]; zs.avail_out = (uInt)buf.size();
+    deflate(&zs, Z_FINISH);
+    out.write(&buf[0], (std::streamsize)zs.total_out);
+    deflateEnd(&zs);
+}
+
+// bgzip 형식: 블록마다 BC 추가 필드에 블록 크기를 적은 gzip 멤버 + 빈 EOF 블록
+static void writeBgzf(std::ofstream& out, const std::string& text, size_t chunk) {
+    for (size_t pos = 0; pos <= text.size(); pos += chunk) {
+        std::string part = text.substr(pos, chunk); // 마지막은 빈 EOF 블록
+        z_stream zs;
+        std::memset(&zs, 0, sizeof(zs));
+        deflateInit2(&zs, 6, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+        std::vector<unsigned char> body(deflateBound(&zs, (uLong)part.size()) + 64);
+        zs.next_in = (Bytef*)part.data(); zs.avail_in = (uInt)part.size();
+        zs.next_out = &body[0]; zs.avail_out = (uInt)body.size();
+        deflate(&zs, Z_FINISH);
+        size_t clen = zs.total_out;
+        deflateEnd(&zs);
+        size_t bsize = 18 + clen + 8 - 1;
+        unsigned long crc = crc32(0, (const Bytef*)part.data(), (uInt)part.size());
+        unsigned char header[18] = { 0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff, 6, 0, 'B', 'C', 2, 0,
+                                     (unsigned char)(bsize & 0xff), (unsigned char)(bsize >> 8) };
+        unsigned char trailer[8];
+        for (int i = 0; i < 4; ++i) { trailer[i] = (unsigned char)(crc >> (8 * i)); trailer[4 + i] = (unsigned char)(part.size() >> (8 * i)); }
+        out.write((const char*)header, 18);
+        out.write((const char*)&body[0], (std::streamsize)clen);
+        out.write((const char*)trailer, 8);
+        if (part.empty()) break;
+    }
+}
+
+TEST(CompressedInputTest, GzipAndBgzfMatchPlainLoad) {
+    const std::string text = makeManyPlayersLog(400, 6000) + "Odd monday\r\nBadDay funday\n";
+    std::ofstream("ut_plain.log", std::ios::binary) << text;
+    const std::string expected = loadSummary("ut_plain.log");
+    {
+        std::ofstream gz("ut_multi.log.gz", std::ios::binary); // 멤버 두 개를 이어 붙임
+        writeGzipMember(gz, text.substr(0, 12345));
+        writeGzipMember(gz, text.substr(12345));
+        std::ofstream bgzf("ut_blocks.log.gz", std::ios::binary);
+        writeBgzf(bgzf, text, 3000);
+        std::ofstream mixed("ut_mixed.log.gz", std::ios::binary); // BGZF 뒤에 일반 gzip 멤버
+        writeBgzf(mixed, text.substr(0, 40000), 5000);
+        writeGzipMember(mixed, text.substr(40000));
+    }
+    const char* paths[] = { "ut_multi.log.gz", "ut_blocks.log.gz", "ut_mixed.log.gz" };
+    const CompressionFormat formats[] = { Gzip, Bgzf, Bgzf };
+    for (int i = 0; i < 3; ++i) {
+        AttendanceSystem sys;
+        CompressedLoader loader(sys);
+        loader.setThreadCount(3);
+        loader.setBlockBytes(4096); // 작업/창이 여러 번 돌도록 작게
+        ASSERT_TRUE(loader.loadFromFile(paths[i])) << paths[i];
+        EXPECT_EQ(formats[i], loader.lastFormat());
+        EXPECT_EQ(expected, summaryOf(sys)) << paths[i];
+    }
+
+    CompressedStreamBuf buf(2);
+    ASSERT_TRUE(buf.open("ut_blocks.log.gz"));
+    std::istream in(&buf);
+    AttendanceSystem viaStream;
+    viaStream.loadFromStream(in);
+    EXPECT_EQ(expected, summaryOf(viaStream));
+
+    std::remove("ut_plain.log");
+    for (int i = 0; i < 3; ++i) std::remove(paths[i]);
+}
+
+TEST(CompressedInputTest, GzipAnyBlockSizeMatchesPlainLoad) {
+    // 출력 블록이 가득 차는 순간과 입력 창이 비는 순간이 겹치는 경우가 나오도록 작은 크기를 훑음
+    const std::string text = makeManyPlayersLog(100, 3000);
+    std::ofstream("ut_single.log", std::ios::binary) << text;
+    const std::string expected = loadSummary("ut_single.log");
+    {
+        std::ofstream gz("ut_single.log.gz", std::ios::binary);
+        writeGzipMember(gz, text);
+    }
+    for (size_t blockBytes = 16; blockBytes <= 4096; blockBytes += (blockBytes < 256 ? 1 : 61)) {
+        AttendanceSystem sys;
+        CompressedLoader loader(sys);
+        loader.setThreadCount(2);
+        loader.setBlockBytes(blockBytes);
+        ASSERT_TRUE(loader.loadFromFile("ut_single.log.gz")) << blockBytes;
+        EXPECT_EQ(Gzip, loader.lastFormat());
+        ASSERT_EQ(expected, summaryOf(sys)) << blockBytes;
+    }
+    std::remove("ut_single.log");
+    std::remove("ut_single.log.gz");
+}
+
+TEST(CompressedInputTest, TruncatedArchiveFails) {
+    const std::string text = makeManyPlayersLog(100, 3000);
+    {
+        std::ofstream gz("ut_whole.log.gz", std::ios::binary);
+        writeGzipMember(gz, text);
+        std::ofstream bgzf("ut_whole.bgz", std::ios::binary);
+        writeBgzf(bgzf, text, 2000);
+    }
+    const char* paths[] = { "ut_whole.log.gz", "ut_whole.bgz" };
+    for (int i = 0; i < 2; ++i) {
+        std::string data = readFileText(paths[i]);
+        std::ofstream(paths[i], std::ios::binary) << data.substr(0, data.size() / 2);
+
+        AttendanceSystem sys;
+        CompressedLoader loader(sys);
+        loader.setBlockBytes(1024);
+        EXPECT_FALSE(loader.loadFromFile(paths[i])) << paths[i];
+        EXPECT_FALSE(sys.players().empty()); // 잘리기 전까지는 반영됨
+        std::remove(paths[i]);
+    }
+}
+#endif
+
+#ifdef ATTENDANCE_WITH_ZSTD
+// 내용 크기가 헤더에 적힌 프레임
+static void writeZstdFrame(std::ofstream& out, const std::string& text) {
+    std::vector<char> buf(ZSTD_compressBound(text.size()));
+    size_t n = ZSTD_compress(&buf[0], buf.size(), text.data(), text.size(), 3);
+    out.write(&buf[0], (std::streamsize)n);
+}
+
+// 스트리밍 압축: 내용 크기가 헤더에 없는 프레임
+static void writeZstdStreamFrame(std::ofstream& out, const std::string& text) {
+    ZSTD_CCtx* cctx = ZSTD_createCCtx();
+    std::vector<char> buf(ZSTD_CStreamOutSize());
+    ZSTD_inBuffer ib = { text.data(), text.size(), 0 };
+    size_t rc;
+    do {
+        ZSTD_outBuffer ob = { &buf[0], buf.size(), 0 };
+        rc = ZSTD_compressStream2(cctx, &ob, &ib, ZSTD_e_end);
+        out.write(&buf[0], (std::streamsize)ob.pos);
+    } while (rc != 0 && !ZSTD_isError(rc));
+    ZSTD_freeCCtx(cctx);
+}
+
+TEST(CompressedInputTest, ZstdFramesMatchPlainLoad) {
+    const std::string text = makeManyPlayersLog(400, 6000) + "Odd monday\r\nBadDay funday\n";
+    std::ofstream("ut_zplain.log", std::ios::binary) << text;
+    const std::string expected = loadSummary("ut_zplain.log");
+    {
+        std::ofstream frames("ut_frames.log.zst", std::ios::binary); // 프레임 여러 개 -> 병렬 해제
+        for (size_t pos = 0; pos < text.size(); pos += 7000) writeZstdFrame(frames, text.substr(pos, 7000));
+        std::ofstream streamed("ut_streamed.log.zst", std::ios::binary); // 크기 없는 프레임 하나
+        writeZstdStreamFrame(streamed, text);
+        std::ofstream mixed("ut_zmixed.log.zst", std::ios::binary); // 크기 있는 프레임 뒤에 크기 없는 프레임들
+        writeZstdFrame(mixed, text.substr(0, 40000));
+        writeZstdStreamFrame(mixed, text.substr(40000, 20000));
+        writeZstdStreamFrame(mixed, text.substr(60000));
+    }
+    const char* paths[] = { "ut_frames.log.zst", "ut_streamed.log.zst", "ut_zmixed.log.zst" };
+    for (int i = 0; i < 3; ++i) {
+        AttendanceSystem sys;
+        CompressedLoader loader(sys);
+        loader.setThreadCount(3);
+        loader.setBlockBytes(4096);
+        ASSERT_TRUE(loader.loadFromFile(paths[i])) << paths[i];
+        EXPECT_EQ(Zstd, loader.lastFormat());
+        EXPECT_EQ(expected, summaryOf(sys)) << paths[i];
+    }
+
+    // 잘린 프레임은 실패
+    std::string data = readFileText(paths[0]);
+    std::ofstream(paths[0], std::ios::binary) << data.substr(0, data.size() / 2);
+    AttendanceSystem sys;
+    CompressedLoader loader(sys);
+    loader.setBlockBytes(4096);
+    EXPECT_FALSE(loader.loadFromFile(paths[0]));
+
+    std::remove("ut_zplain.log");
+    for (int i = 0; i < 3; ++i) std::remove(paths[i]);
+}
+#endif
+
+// 그룹 집계 테스트
+static void makeOrgChart(GroupHierarchy& org, const AttendanceSystem& sys) {
+    std::stringstream chart;
+    chart << "# 부서 -> 팀\ngroup Sales\ngroup Dev\ngroup Platform Dev\ngroup Apps Dev\ngroup Infra Platform\n";
+    for (size_t i = 0; i < sys.players().size(); ++i) {
+        static const char* teams[] = { "Sales", "Platform", "Apps", "Infra", "Dev" };
+        if (i % 6 != 5) chart << "member " << sys.players()[i].name << " " << teams[i % 6 % 5] << "\n"; // 6명 중 1명은 소속 없음
+    }
+    chart << "member Nobody Unknown\ngroup Orphan Missing\nbogus line\n";
+    EXPECT_FALSE(org.loadFromStream(chart));
+}
+
+TEST(GroupRollupTest, MatchesPerPlayerResults) {
+    AttendanceSystem sys;
+    std::stringstream log(makeManyPlayersLog(60, 1500));
+    sys.loadFromStream(log);
+    GroupHierarchy org;
+    makeOrgChart(org, sys);
+    ASSERT_EQ(5, org.groupCount());
+    EXPECT_EQ(3u, org.rejectedLines()); // 모르는 그룹 2줄 + 형식 오류 1줄
+    EXPECT_EQ(50u, org.memberCount());
+    EXPECT_EQ(-1, org.findGroup("Orphan"));
+    EXPECT_EQ(-1, org.groupOf("Nobody"));
+
+    sys.setHierarchy(&org);
+    sys.compute();
+    const GroupRollup& r = sys.rollup();
+    ASSERT_EQ(5, r.groupCount());
+
+    // 기대값: 플레이어 결과를 소속 그룹과 모든 상위 그룹에 직접 더함
+    std::vector<int> members(5, 0), eliminated(5, 0);
+    std::vector<long long> points(5, 0);
+    std::map<std::string, std::vector<int> > grades;
+    for (size_t i = 0; i < sys.players().size(); ++i) {
+        const PlayerStat& p = sys.players()[i];
+        for (int g = org.groupOf(p.name); g >= 0; g = org.parentOf(g)) {
+            ++members[g]; points[g] += p.totalPoints; eliminated[g] += p.eliminationCandidate ? 1 : 0;
+            std::vector<int>& col = grades[p.grade];
+            col.resize(5, 0);
+            ++col[g];
+        }
+    }
+    EXPECT_EQ(members, r.members);
+    EXPECT_EQ(points, r.pointSum);
+    EXPECT_EQ(eliminated, r.eliminated);
+    ASSERT_EQ(grades.size(), r.gradeNames.size());
+    for (size_t c = 0; c < r.gradeNames.size(); ++c) EXPECT_EQ(grades[r.gradeNames[c]], r.gradeCount[c]) << r.gradeNames[c];
+    EXPECT_GT(r.members[org.findGroup("Platform")], r.members[org.findGroup("Infra")]); // 하위 팀 포함
+
+    std::ostringstream oss;
+    sys.printRollup(oss);
+    EXPECT_NE(std::string::npos, oss.str().find("GROUP : Dev, MEMBERS : "));
+}
+
+TEST(GroupRollupTest, ReusedAcrossBatchesAndDetached) {
+    GroupHierarchy org;
+    int dept = org.addGroup("Dept");
+    int team = org.addGroup("Team", dept);
+    EXPECT_EQ(dept, org.addGroup("Dept"));
+    EXPECT_EQ(-1, org.addGroup("Bad", 7));
+    EXPECT_FALSE(org.assign("Amy", 9));
+    ASSERT_TRUE(org.assign("Amy", team));
+    ASSERT_TRUE(org.assign("Bob", dept));
+
+    AttendanceSystem sys;
+    sys.setHierarchy(&org);
+    for (int batch = 0; batch < 2; ++batch) {
+        sys.clear();
+        if (batch == 1) sys.addRecord("Cat", Sun); // 플레이어 인덱스가 배치마다 달라도 소속은 새로 조회
+        sys.addRecord(batch == 0 ? "Amy" : "Bob", batch == 0 ? Wed : Mon);
+        sys.addRecord(batch == 0 ? "Bob" : "Amy", batch == 0 ? Mon : Wed);
+        if (batch == 0) sys.addRecord("Cat", Sun);
+        sys.compute();
+        const GroupRollup& r = sys.rollup();
+        EXPECT_EQ(2, r.members[dept]);
+        EXPECT_EQ(1, r.members[team]);
+        EXPECT_EQ(4, r.pointSum[dept]);
+        EXPECT_EQ(3, r.pointSum[team]);
+        EXPECT_EQ(1, r.eliminated[dept]);
+        EXPECT_EQ(0, r.eliminated[team]);
+        ASSERT_EQ(0, r.gradeColumn("NORMAL"));
+        EXPECT_EQ(2, r.gradeCount[0][dept]);
+    }
+
+    sys.setHierarchy(0);
+    sys.compute();
+    EXPECT_EQ(0, sys.rollup().groupCount());
+    std::ostringstream oss;
+    sys.printRollup(oss);
+    EXPECT_TRUE(oss.str().empty());
+    EXPECT_FALSE(org.loadFromFile("__no_such_file__.txt"));
+}
+
+TEST(GroupRollupTest, MembersMatchedByNormalizedKey) {
+    GroupHierarchy org;
+    int team = org.addGroup("Team");
+    std::stringstream chart("member AMY Team\nmember bob Team\nmember Bad\xff Team\n");
+    ASSERT_TRUE(org.loadFromStream(chart));
+    EXPECT_EQ(0u, org.rejectedLines());
+
+    DefaultNameNormalizer norm;
+    AttendanceSystem sys;
+    sys.setNameNormalizer(&norm);
+    sys.addRecord("Amy", Mon);
+    sys.setHierarchy(&org);        // 지정 전에 있던 플레이어
+    sys.addRecord("BOB", Wed);     // 지정 뒤에 생긴 플레이어
+    sys.addRecord("Cat", Sun);
+    sys.addRecord("Bad\xff", Sun); // 정규화에서 거부 (조직도의 같은 이름도 건너뜀)
+    sys.compute();
+    EXPECT_EQ(1u, sys.rejectedCount());
+    EXPECT_EQ(2, sys.rollup().members[team]);
+    EXPECT_EQ(4, sys.rollup().pointSum[team]);
+
+    org.clear();
+    EXPECT_FALSE(org.addLine("member Amy"));
+    EXPECT_EQ(1u, org.rejectedLines());
+}
+
+// 결과 내보내기 테스트
+static std::string exportText(const AttendanceSystem& sys, const IResultWriter& writer, ColumnMask cols, size_t chunkRows) {
+    ResultExporter exporter(sys);
+    exporter.setColumns(cols);
+    exporter.setChunkRows(chunkRows);
+    std::ostringstream oss;
+    exporter.exportTo(oss, writer);
+    return oss.str();
+}
+
+static unsigned readU32(const std::string& s, size_t& pos) {
+    unsigned v = 0;
+    for (int i = 0; i < 4; ++i) v |= (unsigned)(unsigned char)s[pos + i] << (8 * i);
+    pos += 4;
+    return v;
+}
+
+TEST(ResultExportTest, CsvAndJsonLinesMatchPlayerStats) {
+    AttendanceSystem sys;
+    std::stringstream log(makeManyPlayersLog(40, 900));
+    sys.loadFromStream(log);
+    sys.addRecord("Comma,\"Quoted\"", Wed);
+    sys.compute();
+    ASSERT_GT(sys.players().size(), 1u);
+
+    ColumnMask cols = 0;
+    ASSERT_TRUE(parseColumnList("name,wed,total,grade,eliminated", cols));
+    EXPECT_FALSE(parseColumnList("name,nope", cols));
+
+    std::ostringstream csv, jsonl;
+    csv << "name,wed,total,grade,eliminated\n";
+    for (size_t i = 0; i < sys.players().size(); ++i) {
+        const PlayerStat& p = sys.players()[i];
+        bool quoted = p.name.find(',') != std::string::npos;
+        csv << (quoted ? "\"Comma,\"\"Quoted\"\"\"" : p.name) << "," << p.dayCount[Wed] << "," << p.totalPoints << "," << p.grade << "," << (p.eliminationCandidate ? 1 : 0) << "\n";
+        jsonl << "{\"name\":\"" << (quoted ? "Comma,\\\"Quoted\\\"" : p.name) << "\",\"wed\":" << p.dayCount[Wed] << ",\"total\":" << p.totalPoints
+              << ",\"grade\":\"" << p.grade << "\",\"eliminated\":" << (p.eliminationCandidate ? "true" : "false") << "}\n";
+    }
+    EXPECT_EQ(csv.str(), exportText(sys, CsvResultWriter(), cols, 3));
+    EXPECT_EQ(jsonl.str(), exportText(sys, JsonLinesResultWriter(), cols, 7));
+    EXPECT_EQ(exportText(sys, CsvResultWriter(), AllColumns, 1), exportText(sys, CsvResultWriter(), AllColumns, 4096));
+    EXPECT_EQ(0u, exportText(sys, CsvResultWriter(), AllColumns, 64).find("id,name,mon,tue,wed,thu,fri,sat,sun,base,bonus,total,grade,eliminated\n1,"));
+}
+
+TEST(ResultExportTest, ColumnarBinaryRoundTrip) {
+    AttendanceSystem sys;
+    std::stringstream log(makeManyPlayersLog(40, 900));
+    sys.loadFromStream(log);
+    sys.compute();
+    const PlayerList players = sys.players();
+    ASSERT_GT(players.size(), 0u);
+    const ColumnMask cols = columnBit(ColName) | columnBit(ColSat) | columnBit(ColTotalPoints) | columnBit(ColEliminated);
+    const std::string data = exportText(sys, ColumnarBinaryResultWriter(), cols, 8);
+
+    ASSERT_EQ(0, data.compare(0, 8, std::string("ATTCOL1\0", 8)));
+    size_t pos = 8;
+    ASSERT_EQ(cols, readU32(data, pos));
+    size_t row = 0;
+    while (pos < data.size()) {
+        size_t n = readU32(data, pos);
+        ASSERT_LE(row + n, players.size());
+        std::vector<unsigned> offsets;
+        for (size_t i = 0; i <= n; ++i) offsets.push_back(readU32(data, pos));
+        for (size_t i = 0; i < n; ++i) EXPECT_EQ(players[row + i].name, data.substr(pos + offsets[i], offsets[i + 1] - offsets[i]));
+        pos += offsets[n];
+        for (size_t i = 0; i < n; ++i) EXPECT_EQ(players[row + i].dayCount[Sat], (int)readU32(data, pos));
+        for (size_t i = 0; i < n; ++i) EXPECT_EQ(players[row + i].totalPoints, (int)readU32(data, pos));
+        for (size_t i = 0; i < n; ++i) EXPECT_EQ(players[row + i].eliminationCandidate ? 1 : 0, data[pos++]);
+        row += n;
+    }
+    EXPECT_EQ(players.size(), row);
+}
+
+TEST(ResultExportTest, JsonEscapesInvalidUtf8) {
+    AttendanceSystem sys;
+    sys.addRecord("Zo\xc3\xab", Mon);      // 올바른 UTF-8은 그대로
+    sys.addRecord("Bad\xff\xc3", Mon);     // 잘못된 바이트, 잘린 2바이트 문자
+    sys.addRecord("\xed\xa0\x80x", Mon);  // 서로게이트
+    sys.compute();
+    EXPECT_EQ("{\"name\":\"Zo\xc3\xab\"}\n{\"name\":\"Bad\\u00ff\\u00c3\"}\n{\"name\":\"\\u00ed\\u00a0\\u0080x\"}\n",
+              exportText(sys, JsonLinesResultWriter(), columnBit(ColName), 2));
+}
+
+TEST(ResultExportTest, PartitionedFilesConcatenateToSingleExport) {
+    AttendanceSystem sys;
+    std::stringstream ss(makeManyPlayersLog(500, 4000));
+    sys.loadFromStream(ss);
+    sys.compute();
+
+    ResultExporter exporter(sys);
+    exporter.setThreadCount(3);
+    exporter.setChunkRows(50);
+    std::vector<std::string> paths;
+    JsonLinesResultWriter jsonl;
+    ASSERT_TRUE(exporter.exportPartitioned("ut_export", 4, jsonl, &paths));
+    ASSERT_EQ(4u, paths.size());
+    EXPECT_EQ("ut_export-003.jsonl", paths[3]);
+    std::string joined;
+    for (size_t i = 0; i < paths.size(); ++i) { joined += readFileText(paths[i]); std::remove(paths[i].c_str()); }
+    EXPECT_EQ(exportText(sys, jsonl, AllColumns, 4096), joined);
+
+    EXPECT_FALSE(exporter.exportPartitioned("__no_such_dir__/part", 2, jsonl));
+    EXPECT_FALSE(exporter.exportToFile("__no_such_dir__/all.csv", CsvResultWriter()));
+}
+
+// 이름 정규화 테스트
+TEST(NameNormalizerTest, ValidatesUtf8) {
+    const std::string ascii(40, 'a');
+    EXPECT_TRUE(isValidUtf8(ascii.data(), ascii.size()));
+    EXPECT_TRUE(isValidUtf8("\xed\x95\x9c\xea\xb8\x80 Zo\xc3\xab \xf0\x9f\x98\x80", 16));
+    const char* invalid[] = {
+        "\xff", "\xc0\x80", "\xe0\x80\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xc3", "\x80", "\xe2\x82"
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        EXPECT_FALSE(isValidUtf8(invalid[i], std::strlen(invalid[i]))) << i;
+        std::string tail = ascii + invalid[i]; // SIMD 구간 뒤의 잘못된 바이트
+        EXPECT_FALSE(isValidUtf8(tail.data(), tail.size())) << i;
+    }
+}
+
+TEST(NameNormalizerTest, CanonicalKeys) {
+    DefaultNameNormalizer n;
+    std::string a, b;
+    const char* same[][2] = {
+        { "ALICE", "alice" },
+        { "Zo\xc3\xab", "ZOE\xcc\x88" },                          // ë = e + U+0308
+        { "\xc3\x89mile", "\xc3\xa9MILE" },                         // É/é (Latin-1 대소문자)
+        { "\xc5\xa0imon", "S\xcc\x8cimon" },                        // Š = S + U+030C
+        { "\xed\x95\x9c\xea\xb8\x80", "\xe1\x84\x92\xe1\x85\xa1\xe1\x86\xab\xe1\x84\x80\xe1\x85\xb3\xe1\x86\xaf" }, // 한글 = 첫가끝 자모
+    };
+    for (size_t i = 0; i < sizeof(same) / sizeof(same[0]); ++i) {
+        ASSERT_TRUE(n.normalize(same[i][0], a)) << i;
+        ASSERT_TRUE(n.normalize(same[i][1], b)) << i;
+        EXPECT_EQ(a, b) << i;
+        EXPECT_TRUE(isValidUtf8(a.data(), a.size()));
+    }
+    EXPECT_TRUE(n.normalize("Bob", a));
+    EXPECT_EQ("bob", a);
+    EXPECT_FALSE(n.normalize("", a));
+    EXPECT_FALSE(n.normalize("bad\x01name", a));
+    EXPECT_FALSE(n.normalize("bad\xc2\x85", a)); // C1 제어 문자
+    EXPECT_FALSE(n.normalize("stray\xff", a));
+}
+
+TEST(NameNormalizerTest, MergesVariantsAndCountsRejects) {
+    std::stringstream ss;
+    ss << "Alice wednesday\nalice monday\nALICE sunday\n"
+       << "Zo\xc3\xab monday\nZOE\xcc\x88 tuesday\n"
+       << "\xed\x95\x9c\xea\xb8\x80 friday\n\xe1\x84\x92\xe1\x85\xa1\xe1\x86\xab\xe1\x84\x80\xe1\x85\xb3\xe1\x86\xaf friday\n"
+       << "Bad\xff monday\nBob funday\nBob monday\n";
+
+    DefaultNameNormalizer normalizer;
+    AttendanceSystem sys;
+    sys.addRecord("Stale", Mon);
+    sys.setNameNormalizer(&normalizer);
+    EXPECT_TRUE(sys.players().empty());
+    sys.loadFromStream(ss);
+    sys.compute();
+
+    ASSERT_EQ(4u, sys.players().size());
+    EXPECT_EQ("Alice", sys.players()[0].name); // 처음 본 표기 유지
+    EXPECT_EQ(1, sys.players()[0].dayCount[Wed]);
+    EXPECT_EQ(1, sys.players()[0].dayCount[Mon]);
+    EXPECT_EQ(1, sys.players()[0].dayCount[Sun]);
+    EXPECT_EQ(3 + 1 + 2, sys.players()[0].basePoints);
+    EXPECT_EQ("Zo\xc3\xab", sys.players()[1].name);
+    EXPECT_EQ(2, sys.players()[2].dayCount[Fri]);
+    EXPECT_EQ(0, sys.indexOf("aLiCe"));
+    EXPECT_EQ(-1, sys.indexOf("Bad\xff"));
+    EXPECT_EQ(2u, sys.rejectedCount());
+    EXPECT_FALSE(sys.addRecordLine("x\x7f", "monday"));
+    EXPECT_EQ(3u, sys.rejectedCount());
+
+    // 정규화 없이: 원래 바이트 그대로, 잘못된 요일만 거부
+    AttendanceSystem raw;
+    raw.addRecordLine("Alice", "monday");
+    raw.addRecordLine("alice", "monday");
+    EXPECT_FALSE(raw.addRecordLine("Alice", "funday"));
+    EXPECT_EQ(2u, raw.players().size());
+    EXPECT_EQ(1u, raw.rejectedCount());
+    raw.clear();
+    EXPECT_EQ(0u, raw.rejectedCount());
+}
+
+TEST(NameNormalizerTest, RejectedCountIsPerRecordInEveryLoader) {
+    // 같은 이름이 여러 번 거부돼도 기록마다 셈 (부분 집계본을 거치는 경로도 같아야 함)
+    const std::string log = "Bad\xff monday\nGood monday\nBad\xff friday\nGood funday\nx\x7f tuesday\nBad\xff monday\nx\x7f sunday\n";
+    std::ofstream("ut_rejects.log", std::ios::binary) << log;
+    DefaultNameNormalizer norm;
+
+    AttendanceSystem exact;
+    exact.setNameNormalizer(&norm);
+    std::stringstream in(log);
+    exact.loadFromStream(in);
+    ASSERT_EQ(6u, exact.rejectedCount());
+
+    AttendanceSystem viaPartial;
+    viaPartial.setNameNormalizer(&norm);
+    PartialAggregate agg;
+    parseRecords(log.data(), log.size(), agg);
+    EXPECT_EQ(1u, agg.rejectedCount()); // 잘못된 요일
+    std::stringstream saved;
+    agg.save(saved);
+    PartialAggregate loaded;
+    ASSERT_TRUE(loaded.load(saved));
+    loaded.applyTo(viaPartial);
+    EXPECT_EQ(6u, viaPartial.rejectedCount());
+    EXPECT_EQ(6u, PartialAggregate::fromSystem(viaPartial, 0).rejectedCount());
+
+    AttendanceSystem viaFiles;
+    viaFiles.setNameNormalizer(&norm);
+    MultiFileLoader files(viaFiles);
+    ASSERT_TRUE(files.loadFromFiles(std::vector<std::string>(2, "ut_rejects.log")));
+    EXPECT_EQ(12u, viaFiles.rejectedCount());
+
+    AttendanceSystem viaCompressed;
+    viaCompressed.setNameNormalizer(&norm);
+    CompressedLoader compressed(viaCompressed);
+    compressed.setBlockBytes(16); // 레코드가 블록 경계에 걸치도록
+    ASSERT_TRUE(compressed.loadFromFile("ut_rejects.log"));
+    EXPECT_EQ(6u, viaCompressed.rejectedCount());
+
+    AttendanceSystem viaCheckpoint;
+    viaCheckpoint.setNameNormalizer(&norm);
+    std::remove("ut_rejects.ckpt");
+    CheckpointedLoader ckpt(viaCheckpoint, "ut_rejects.ckpt");
+    ASSERT_TRUE(ckpt.loadFromFile("ut_rejects.log"));
+    EXPECT_EQ(6u, viaCheckpoint.rejectedCount());
+
+    std::remove("ut_rejects.log");
+    std::remove("ut_rejects.ckpt");
+}
+
+// 재사용 테스트: 힙 할당 횟수 측정용 전역 operator new 교체 (테스트 빌드 전용)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // 교체한 new/delete 쌍을 오탐함
+#endif
+
+static bool g_countAllocs = false;
+static size_t g_allocCount = 0;
+
+// 테스트 바이너리 전체에 적용되므로 new/delete 짝(배열, nothrow, sized)을 모두 malloc/free로 맞춤
+// (일부만 바꾸면 다른 테스트의 nothrow new 버퍼가 free로 해제되어 할당기 불일치)
+void* operator new(std::size_t size) {
+    if (g_countAllocs) ++g_allocCount;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    if (g_countAllocs) ++g_allocCount;
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return operator new(size, std::nothrow); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+TEST(ReuseTest, SteadyStateBatchesDoNotAllocate) {
+    std::vector<std::string> names;
+    for (int i = 0; i < 300; ++i) {
+        std::ostringstream oss; oss << "team_member_with_long_name_" << i; // SSO보다 긴 이름
+        names.push_back(oss.str());
+    }
+
+    // 조직도가 있어도 compute의 그룹 집계 버퍼는 재사용
+    GroupHierarchy org;
+    int root = org.addGroup("org");
+    int teams[3] = { org.addGroup("alpha", root), org.addGroup("beta", root), org.addGroup("gamma", root) };
+    for (size_t i = 0; i < names.size(); ++i) org.assign(names[i], teams[i % 3]);
+
+    AttendanceSystem sys;
+    sys.reserve(names.size());
+    sys.setHierarchy(&org);
+    size_t allocs = 0;
+    // 같은 배치 순서를 두 바퀴: 첫 바퀴(최대 인원, 나올 수 있는 등급 열 모두)는 준비 단계
+    for (int batch = 0; batch < 24; ++batch) {
+        if (batch == 12) { g_allocCount = 0; g_countAllocs = true; }
+        sys.clear();
+        int players = (batch % 12 == 0) ? 300 : 100 + (batch % 12 * 37) % 200;
+        for (int r = 0; r < 2000; ++r) sys.addRecord(names[(r * 7) % players], (Weekday)(r % 7));
+        sys.compute();
+    }
+    g_countAllocs = false;
+    allocs = g_allocCount;
+
+    EXPECT_EQ(0u, allocs);
+    EXPECT_EQ((size_t)(100 + (11 * 37) % 200), sys.players().size());
+    EXPECT_EQ(names[0], sys.players()[0].name);
+    EXPECT_EQ((int)sys.players().size(), sys.rollup().members[root]);
+}
+
+TEST(ReuseTest, SteadyStateStreamLoadsWithNormalizerDoNotAllocate) {
+    // 스트림은 미리 만들어 두고 loadFromStream 자체의 할당만 셈
+    std::vector<std::stringstream*> batches;
+    for (int batch = 0; batch < 8; ++batch) {
+        std::ostringstream oss;
+        int players = (batch == 0) ? 300 : 100 + (batch * 37) % 200;
+        for (int r = 0; r < 1500; ++r) {
+            oss << (r % 2 ? "Team_Member_With_Long_Name_" : "team_member_with_long_name_") << (r * 7) % players
+                << " " << kShardDays[r % 7] << "\n";
+        }
+        batches.push_back(new std::stringstream(oss.str()));
+    }
+
+    DefaultNameNormalizer normalizer;
+    AttendanceSystem sys;
+    sys.setNameNormalizer(&normalizer);
+    sys.reserve(300);
+    for (size_t batch = 0; batch < batches.size(); ++batch) {
+        if (batch == 1) { g_allocCount = 0; g_countAllocs = true; }
+        sys.clear();
+        sys.loadFromStream(*batches[batch]);
+        sys.compute();
+    }
+    g_countAllocs = false;
+
+    EXPECT_EQ(0u, g_allocCount);
+    EXPECT_EQ((size_t)(100 + (7 * 37) % 200), sys.players().size());
+    for (size_t i = 0; i < batches.size(); ++i) delete batches[i];
+}
+
+TEST(ReuseTest, ClearKeepsCapacityAndRestartsIds) {
+    AttendanceSystem sys;
+    sys.reserve(1000);
+    for (int i = 0; i < 1000; ++i) { std::ostringstream oss; oss << "P" << i; sys.addRecord(oss.str(), Wed); }
+    size_t cap = sys.players().capacity();
+    ASSERT_GE(cap, 1000u);
+
+    sys.clear();
+    EXPECT_TRUE(sys.players().empty());
+    EXPECT_EQ(cap, sys.players().capacity());
+    EXPECT_EQ(-1, sys.indexOf("P0"));
+
+    sys.addRecord("P5", Mon);
+    sys.addRecord("P0", Mon);
+    sys.addRecord("P5", Tue);
+    ASSERT_EQ(2u, sys.players().size());
+    EXPECT_EQ(0, sys.indexOf("P5"));
+    EXPECT_EQ(1, sys.indexOf("P0"));
+    // 재사용한 칸에 지난 배치의 횟수/점수가 남지 않음
+    sys.compute();
+    const PlayerList ps = sys.players();
+    EXPECT_EQ(1, ps[0].id);
+    EXPECT_EQ("P5", ps[0].name);
+    EXPECT_EQ(0, ps[0].dayCount[Wed]);
+    EXPECT_EQ(1, ps[0].dayCount[Mon]);
+    EXPECT_EQ(1, ps[0].dayCount[Tue]);
+    EXPECT_EQ(2, ps[0].totalPoints);
+    EXPECT_EQ(1, ps[1].totalPoints);
+}
+
 #endif
@@ -0,0 +1,261 @@
+﻿#include "batchScheduler.h"
+#include "multiFileLoader.h"
+#include "partialAggregate.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace {
+
+thread_local WorkStealingPool* tlsPool = 0;
+thread_local int tlsWorker = -1;
+
+typedef std::chrono::steady_clock Clock;
+
+struct ChunkSpec {
+    size_t input;
+    unsigned long long begin, end;
+    bool ok; // 이 청크를 맡은 작업만 씀, 마무리 때 입력별로 모음
+};
+
+struct TenantState {
+    const TenantJob* job;
+    PolicyBundle policies;
+    TenantResult* result;
+    Clock::time_point start;
+    size_t chunkBytes;
+    std::vector<ChunkSpec> chunks;
+    std::vector<PartialAggregate> parts; // chunks와 같은 순서
+    std::vector<char> inputOk;           // PlanTask(열기 실패)와 FinalizeTask(청크 결과 모음)만 씀
+    std::atomic<size_t> remaining;
+};
+
+// [begin, end) 안에서 시작하는 줄들을 읽음 (마지막 줄은 end를 넘어 끝까지)
+bool readChunk(const std::string& path, unsigned long long begin, unsigned long long end, std::vector<char>& buf) {
+    buf.clear();
+    std::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+    if (!fin.is_open()) return false;
+    unsigned long long pos = begin;
+    if (begin > 0) {
+        fin.seekg((std::streamoff)(begin - 1));
+        int c = fin.get();
+        while (c != EOF && c != '\n' && pos < end) { c = fin.get(); ++pos; } // 이전 청크의 줄은 건너뜀
+        if (c == EOF) return true;
+    }
+    if (pos >= end) return true;
+    buf.resize((size_t)(end - pos));
+    fin.read(&buf[0], (std::streamsize)buf.size());
+    buf.resize((size_t)fin.gcount());
+    if (!buf.empty() && buf.back() != '\n') {
+        int c;
+        while ((c = fin.get()) != EOF) { buf.push_back((char)c); if (c == '\n') break; }
+    }
+    return true;
+}
+
+// 테넌트 출력: 청크 순서대로 병합 -> compute -> printSummary
+class FinalizeTask : public ITask {
+public:
+    explicit FinalizeTask(TenantState* s) : s_(s) {}
+    virtual void run(WorkStealingPool&) {
+        AttendanceSystem sys(s_->policies.scoring, s_->policies.grading, s_->policies.elimination);
+        for (size_t i = 0; i < s_->parts.size(); ++i) { s_->parts[i].applyTo(sys); s_->parts[i].clear(); }
+        sys.compute();
+
+        bool ok = true;
+        for (size_t i = 0; i < s_->chunks.size(); ++i) {
+            if (!s_->chunks[i].ok) s_->inputOk[s_->chunks[i].input] = 0;
+        }
+        for (size_t i = 0; i < s_->inputOk.size(); ++i) {
+            if (!s_->inputOk[i]) { std::cerr << "Failed to open file: " << s_->job->inputs[i] << "\n"; ok = false; }
+        }
+        std::ofstream fout(s_->job->outputPath.c_str());
+        if (!fout.is_open()) { std::cerr << "Failed to open file: " << s_->job->outputPath << "\n"; ok = false; }
+        else { sys.printSummary(fout); ok = ok && (bool)fout; }
+
+        s_->result->ok = ok;
+        s_->result->players = sys.players().size();
+        s_->result->seconds = std::chrono::duration<double>(Clock::now() - s_->start).count();
+    }
+private:
+    TenantState* s_;
+};
+
+class ChunkTask : public ITask {
+public:
+    ChunkTask(TenantState* s, size_t idx) : s_(s), idx_(idx) {}
+    virtual void run(WorkStealingPool& pool) {
+        ChunkSpec& c = s_->chunks[idx_];
+        std::vector<char> buf;
+        c.ok = readChunk(s_->job->inputs[c.input], c.begin, c.end, buf);
+        if (c.ok && !buf.empty()) parseRecords(&buf[0], buf.size(), s_->parts[idx_]);
+        if (--s_->remaining == 0) pool.submit(new FinalizeTask(s_));
+    }
+private:
+    TenantState* s_;
+    size_t idx_;
+};
+
+// 입력 크기를 보고 청크를 나눠 제출 (파일 열기/크기 확인도 병렬로)
+class PlanTask : public ITask {
+public:
+    explicit PlanTask(TenantState* s) : s_(s) {}
+    virtual void run(WorkStealingPool& pool) {
+        const std::vector<std::string>& inputs = s_->job->inputs;
+        s_->inputOk.assign(inputs.size(), 1);
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            std::ifstream fin(inputs[i].c_str(), std::ios::in | std::ios::binary);
+            if (!fin.is_open()) { s_->inputOk[i] = 0; continue; }
+            fin.seekg(0, std::ios::end);
+            std::streamoff size = fin.tellg();
+            for (unsigned long long b = 0; size > 0 && b < (unsigned long long)size; b += s_->chunkBytes) {
+                ChunkSpec c; c.input = i; c.begin = b; c.ok = true;
+                c.end = std::min(b + s_->chunkBytes, (unsigned long long)size);
+                s_->chunks.push_back(c);
+            }
+        }
+        s_->parts.resize(s_->chunks.size());
+        if (s_->chunks.empty()) { FinalizeTask(s_).run(pool); return; }
+        s_->remaining = s_->chunks.size();
+        for (size_t i = 0; i < s_->chunks.size(); ++i) pool.submit(new ChunkTask(s_, i));
+    }
+private:
+    TenantState* s_;
+};
+
+} // namespace
+
+// WorkStealingPool
+WorkStealingPool::WorkStealingPool(int threads) : queued_(0), pending_(0), nextVictim_(0), stop_(false) {
+    int n = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+    if (n <= 0) n = 1;
+    for (int i = 0; i < n; ++i) workers_.push_back(new Worker());
+    for (int i = 0; i < n; ++i) threads_.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (size_t i = 0; i < threads_.size(); ++i) threads_[i].join();
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        for (size_t k = 0; k < workers_[i]->tasks.size(); ++k) delete workers_[i]->tasks[k];
+        delete workers_[i];
+    }
+}
+
+int WorkStealingPool::threadCount() const { return (int)workers_.size(); }
+
+void WorkStealingPool::submit(ITask* task) {
+    ++pending_;
+    size_t self = (tlsPool == this) ? (size_t)tlsWorker : nextVictim_++ % workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[self]->mutex);
+        workers_[self]->tasks.push_back(task);
+    }
+    ++queued_;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    wake_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    while (pending_ != 0) idle_.wait(lock);
+}
+
+ITask* WorkStealingPool::take(int self) {
+    const int n = (int)workers_.size();
+    {
+        Worker& w = *workers_[self];
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if (!w.tasks.empty()) { ITask* t = w.tasks.back(); w.tasks.pop_back(); --queued_; return t; }
+    }
+    for (int k = 1; k < n; ++k) {
+        Worker& v = *workers_[(self + k) % n];
+        std::lock_guard<std::mutex> lock(v.mutex);
+        if (!v.tasks.empty()) { ITask* t = v.tasks.front(); v.tasks.pop_front(); --queued_; return t; }
+    }
+    return 0;
+}
+
+void WorkStealingPool::workerLoop(int self) {
+    tlsPool = this;
+    tlsWorker = self;
+    for (;;) {
+        ITask* t = take(self);
+        if (t) {
+            t->run(*this);
+            delete t;
+            if (--pending_ == 0) {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                idle_.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        if (stop_) return;
+        if (queued_ == 0) wake_.wait(lock);
+    }
+}
+
+// BatchScheduler
+BatchScheduler::BatchScheduler(int threads) : threads_(threads), chunkBytes_(8u << 20) {}
+
+BatchScheduler::~BatchScheduler() {
+    for (std::map<IPolicyFactory*, PolicyBundle>::iterator it = sharedPolicies_.begin(); it != sharedPolicies_.end(); ++it) {
+        delete it->second.scoring; delete it->second.grading; delete it->second.elimination;
+    }
+}
+
+void BatchScheduler::setChunkBytes(size_t bytes) { if (bytes > 0) chunkBytes_ = bytes; }
+
+bool BatchScheduler::addTenant(const TenantJob& job) {
+    // 테넌트들이 병렬로 출력하므로 같은 파일을 쓰면 결과가 서로 덮어써짐
+    if (!outputPaths_.insert(job.outputPath).second) {
+        std::cerr << "Duplicate output path: " << job.outputPath << "\n";
+        return false;
+    }
+    jobs_.push_back(job);
+    return true;
+}
+
+const std::vector<TenantResult>& BatchScheduler::results() const { return results_; }
+
+bool BatchScheduler::run() {
+    // 같은 팩토리의 정책은 한 번만 만들어 읽기 전용으로 공유
+    DefaultPolicyFactory defaultFactory;
+    for (size_t i = 0; i < jobs_.size(); ++i) {
+        IPolicyFactory* f = jobs_[i].factory;
+        if (sharedPolicies_.find(f) == sharedPolicies_.end()) sharedPolicies_[f] = (f ? f : &defaultFactory)->create();
+    }
+
+    results_.assign(jobs_.size(), TenantResult());
+    std::vector<TenantState*> states;
+    Clock::time_point start = Clock::now();
+    {
+        WorkStealingPool pool(threads_);
+        for (size_t i = 0; i < jobs_.size(); ++i) {
+            TenantState* s = new TenantState();
+            s->job = &jobs_[i];
+            s->policies = sharedPolicies_[jobs_[i].factory];
+            s->result = &results_[i];
+            s->result->name = jobs_[i].name; s->result->ok = false; s->result->players = 0; s->result->seconds = 0;
+            s->start = start;
+            s->chunkBytes = chunkBytes_;
+            s->remaining = 0;
+            states.push_back(s);
+        }
+        // 큰 테넌트는 청크로 쪼개져 한가한 스레드가 훔쳐 가므로 꼬리 지연이 줄어듦
+        for (size_t i = 0; i < states.size(); ++i) pool.submit(new PlanTask(states[i]));
+        pool.wait();
+    }
+    for (size_t i = 0; i < states.size(); ++i) delete states[i];
+
+    bool ok = true;
+    for (size_t i = 0; i < results_.size(); ++i) ok = ok && results_[i].ok;
+    return ok;
+}
@@ -0,0 +1,99 @@
+﻿#pragma once
+
+#include "attendance.h"
+#include "policyFactory.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool;
+
+// 풀에서 실행되는 작업 (실행 후 풀이 delete)
+struct ITask {
+    virtual ~ITask() {}
+    virtual void run(WorkStealingPool& pool) = 0;
+};
+
+// 작업 훔치기 스레드 풀: 스레드마다 자기 덱의 뒤에서 꺼내고(LIFO),
+// 비면 다른 스레드 덱의 앞에서 훔침(FIFO)
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads); // 0 = 하드웨어 스레드 수
+    ~WorkStealingPool();
+
+    void submit(ITask* task); // 소유권 이전. 작업 안에서 호출하면 자기 덱에 넣음
+    void wait();              // 제출한 작업(및 그 작업이 제출한 작업)이 모두 끝날 때까지
+    int threadCount() const;
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<ITask*> tasks;
+    };
+
+    std::vector<Worker*> workers_;
+    std::vector<std::thread> threads_;
+    std::mutex sleepMutex_;
+    std::condition_variable wake_, idle_;
+    std::atomic<size_t> queued_;   // 덱에 들어 있는 작업 수
+    std::atomic<size_t> pending_;  // 아직 끝나지 않은 작업 수
+    std::atomic<size_t> nextVictim_;
+    bool stop_;
+
+    void workerLoop(int self);
+    ITask* take(int self);
+
+    WorkStealingPool(const WorkStealingPool&);
+    WorkStealingPool& operator=(const WorkStealingPool&);
+};
+
+struct TenantJob {
+    std::string name;
+    std::vector<std::string> inputs; // 순서대로 입력 (한 줄에 한 레코드여야 함, BatchScheduler 참고)
+    std::string outputPath;          // printSummary 결과
+    IPolicyFactory* factory;         // 같은 팩토리를 쓰는 테넌트끼리 정책 객체 공유 (0이면 기본 정책)
+
+    TenantJob() : factory(0) {}
+};
+
+struct TenantResult {
+    std::string name;
+    bool ok;
+    size_t players;
+    double seconds; // 배치 시작부터 이 테넌트 출력 완료까지
+};
+
+// 여러 테넌트의 loadFromFile -> compute -> printSummary 를 한 프로세스에서 병렬 실행
+// 큰 입력은 chunkBytes 단위(줄바꿈 경계) 하위 작업으로 나눠 파싱하고
+// 마지막 하위 작업이 끝나면 해당 테넌트의 병합/계산/출력 작업을 이어서 제출함
+// 입력은 한 줄에 "<이름> <요일>" 레코드 하나여야 함. 청크마다 따로 짝을 맞추므로 토큰 수가 홀수인
+// 잘못된 줄이 있으면 청크 경계 이후의 짝 맞춤이 loadFromFile(공백 구분 토큰 쌍)과 달라질 수 있음
+class BatchScheduler {
+public:
+    explicit BatchScheduler(int threads = 0);
+    ~BatchScheduler();
+
+    void setChunkBytes(size_t bytes); // 기본 8MB
+    bool addTenant(const TenantJob& job); // 다른 테넌트와 출력 경로가 같으면 추가하지 않고 false
+
+    bool run(); // 모든 테넌트가 성공하면 true
+    const std::vector<TenantResult>& results() const;
+
+private:
+    int threads_;
+    size_t chunkBytes_;
+    std::vector<TenantJob> jobs_;
+    std::set<std::string> outputPaths_;
+    std::vector<TenantResult> results_;
+    std::map<IPolicyFactory*, PolicyBundle> sharedPolicies_;
+
+    BatchScheduler(const BatchScheduler&);
+    BatchScheduler& operator=(const BatchScheduler&);
+};
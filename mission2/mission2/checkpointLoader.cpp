@@ -0,0 +1,285 @@
+﻿#include "checkpointLoader.h"
+#include "partialAggregate.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace {
+
+const size_t kIdentityBytes = 4096; // 입력 식별용으로 해시하는 앞부분 크기
+
+struct CheckpointBlock {
+    unsigned long long offset;
+    size_t rejected;                   // offset까지 거부된 기록 수 (누적)
+    std::vector<PartialEntry> entries; // firstSeen = 플레이어 인덱스
+};
+
+// 입력 식별: 전체 크기 + 앞부분 해시 (다른 파일이나 바뀐 파일로 이어 읽지 않도록)
+struct InputIdentity {
+    unsigned long long size, hash;
+};
+
+bool identify(std::istream& in, InputIdentity& out) {
+    in.clear();
+    in.seekg(0, std::ios::end);
+    std::streamoff end = in.tellg();
+    if (end < 0) return false;
+    in.seekg(0);
+    char buf[kIdentityBytes];
+    in.read(buf, (std::streamsize)std::min<unsigned long long>(sizeof(buf), (unsigned long long)end));
+    unsigned long long h = 1469598103934665603ULL; // FNV-1a
+    for (std::streamsize i = 0; i < in.gcount(); ++i) { h ^= (unsigned char)buf[i]; h *= 1099511628211ULL; }
+    out.size = (unsigned long long)end;
+    out.hash = h;
+    in.clear();
+    in.seekg(0);
+    return (bool)in;
+}
+
+void writeHeader(std::ostream& os, const InputIdentity& id) {
+    os << "ATTCKPT 2 " << id.size << ' ' << id.hash << '\n';
+}
+
+void writeBlock(std::ostream& os, unsigned long long offset, size_t rejected, const std::vector<PartialEntry>& entries) {
+    os << "CKPT " << offset << ' ' << entries.size() << ' ' << rejected << '\n';
+    for (size_t i = 0; i < entries.size(); ++i) writePartialEntry(os, entries[i]);
+    os << "END " << offset << '\n';
+}
+
+bool lessByIndex(const PartialEntry& a, const PartialEntry& b) { return a.firstSeen < b.firstSeen; }
+
+// tmp로 원본을 한 번에 교체 (원본을 먼저 지우지 않으므로 중간에 죽어도 둘 중 하나는 온전함)
+bool replaceFile(const std::string& tmp, const std::string& path) {
+#ifdef _WIN32
+    return MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+#endif
+}
+
+// 현재 블록의 변경분: 플레이어 인덱스별 요일 횟수 배열 + 이번 블록에서 바뀐 인덱스 목록
+class BlockDelta {
+public:
+    void add(int index, Weekday day) {
+        size_t i = (size_t)index;
+        if (i >= dirty_.size()) { dirty_.resize(i + 1, 0); counts_.resize((i + 1) * 7, 0); }
+        if (!dirty_[i]) { dirty_[i] = 1; touched_.push_back(index); }
+        ++counts_[i * 7 + (int)day];
+    }
+
+    // 변경분을 블록으로 꺼내고 비움 (이름은 플레이어 저장소의 표시 이름 = 정규화하면 실제 키)
+    CheckpointBlock* take(unsigned long long offset, size_t rejected, const PlayerList& players) {
+        CheckpointBlock* block = new CheckpointBlock();
+        block->offset = offset;
+        block->rejected = rejected;
+        block->entries.resize(touched_.size());
+        for (size_t k = 0; k < touched_.size(); ++k) {
+            size_t i = (size_t)touched_[k];
+            PartialEntry& e = block->entries[k];
+            e.firstSeen = i;
+            e.name = players[i].name;
+            for (int d = 0; d < 7; ++d) { e.dayCount[d] = counts_[i * 7 + d]; counts_[i * 7 + d] = 0; }
+            dirty_[i] = 0;
+        }
+        touched_.clear();
+        return block;
+    }
+
+private:
+    std::vector<int> counts_;            // [index * 7 + day]
+    std::vector<unsigned char> dirty_;
+    std::vector<int> touched_;
+};
+
+// 블록 단위로 덧붙이는 백그라운드 기록기 (대기열은 최대 2개로 제한)
+// 열기/쓰기에 실패하면 이후 블록은 버리고 finish()가 false를 돌려줌
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(const std::string& path)
+        : out_(path.c_str(), std::ios::out | std::ios::app), stop_(false), failed_(!out_.is_open()),
+        thread_(&CheckpointWriter::run, this) {
+    }
+
+    ~CheckpointWriter() { finish(); }
+
+    // 남은 블록을 모두 쓰고 스레드를 끝냄. 모든 블록이 기록됐으면 true
+    bool finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        ready_.notify_all();
+        if (thread_.joinable()) thread_.join();
+        return !failed_;
+    }
+
+    void push(CheckpointBlock* block) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (queue_.size() >= 2) space_.wait(lock);
+        queue_.push_back(block);
+        ready_.notify_one();
+    }
+
+private:
+    std::ofstream out_;
+    std::mutex mutex_;
+    std::condition_variable ready_, space_;
+    std::deque<CheckpointBlock*> queue_;
+    bool stop_;
+    bool failed_; // 기록 스레드만 씀 (finish의 join 뒤에 읽음)
+    std::thread thread_;
+
+    void run() {
+        for (;;) {
+            CheckpointBlock* block = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                while (queue_.empty() && !stop_) ready_.wait(lock);
+                if (queue_.empty()) return;
+                block = queue_.front(); queue_.pop_front();
+            }
+            space_.notify_one();
+            if (!failed_) {
+                writeBlock(out_, block->offset, block->rejected, block->entries);
+                failed_ = !out_.flush();
+            }
+            delete block;
+        }
+    }
+};
+
+} // namespace
+
+CheckpointedLoader::CheckpointedLoader(AttendanceSystem& sys, const std::string& checkpointPath)
+    : sys_(sys), checkpointPath_(checkpointPath), interval_(100000), resumedOffset_(0) {
+}
+
+void CheckpointedLoader::setInterval(unsigned long long records) { if (records > 0) interval_ = records; }
+
+unsigned long long CheckpointedLoader::resumedOffset() const { return resumedOffset_; }
+
+bool CheckpointedLoader::restore(std::istream& in, unsigned long long& offset) {
+    sys_.clear();
+    offset = 0;
+
+    InputIdentity id;
+    if (!identify(in, id)) { std::cerr << "Failed to read input size for checkpoint\n"; return false; }
+
+    {
+        std::ifstream fin(checkpointPath_.c_str());
+        std::string tag;
+        int version = 0;
+        InputIdentity saved = { 0, 0 };
+        // 머리가 없거나 끊겼으면 체크포인트가 없는 것으로 보고 처음부터
+        // (거부 수가 없는 버전 1도 처음부터 다시 읽음)
+        if (fin.is_open() && fin >> tag >> version >> saved.size >> saved.hash && tag == "ATTCKPT" && version == 2) {
+            if (saved.size != id.size || saved.hash != id.hash) {
+                std::cerr << "Checkpoint does not match input: " << checkpointPath_ << "\n";
+                return false;
+            }
+            unsigned long long blockOffset = 0, endOffset = 0;
+            size_t count = 0, rejected = 0;
+            std::vector<PartialEntry> entries;
+            // 끝까지 온전히 기록된 블록만 적용 (중간에 끊긴 블록은 버림)
+            while (fin >> tag >> blockOffset >> count >> rejected && tag == "CKPT") {
+                entries.resize(count);
+                bool ok = true;
+                for (size_t i = 0; ok && i < count; ++i) ok = readPartialEntry(fin, entries[i]);
+                if (!ok || !(fin >> tag >> endOffset) || tag != "END" || endOffset != blockOffset) break;
+
+                // 기존 플레이어는 같은 인덱스, 새 플레이어는 현재 인원 수부터 빈틈없이 이어져야 함
+                std::sort(entries.begin(), entries.end(), lessByIndex);
+                size_t next = sys_.players().size();
+                for (size_t i = 0; ok && i < entries.size(); ++i) {
+                    int idx = sys_.indexOf(entries[i].name);
+                    if (idx < 0) ok = (entries[i].firstSeen == next++);
+                    else ok = (entries[i].firstSeen == (unsigned long long)idx);
+                }
+                if (!ok || rejected < sys_.rejectedCount()) break; // 거부 수는 누적값이라 줄 수 없음
+
+                for (size_t i = 0; ok && i < entries.size(); ++i) {
+                    ok = (sys_.addDayCounts(entries[i].name, entries[i].dayCount) == (int)entries[i].firstSeen);
+                }
+                if (!ok) { sys_.clear(); offset = 0; break; } // 일부만 반영된 블록 -> 처음부터
+                offset = blockOffset;
+                sys_.addRejected(rejected - sys_.rejectedCount()); // 누적값으로 맞춤
+            }
+        }
+    }
+
+    // 복구한 상태를 블록 하나로 다시 써서 끊긴 꼬리를 제거
+    const std::string tmp = checkpointPath_ + ".tmp";
+    {
+        std::ofstream fout(tmp.c_str(), std::ios::out | std::ios::trunc);
+        if (!fout.is_open()) { std::cerr << "Failed to open file: " << tmp << "\n"; return false; }
+        writeHeader(fout, id);
+        if (offset > 0) {
+            const PlayerList ps = sys_.players();
+            std::vector<PartialEntry> snapshot(ps.size());
+            for (size_t i = 0; i < ps.size(); ++i) {
+                snapshot[i].firstSeen = i;
+                snapshot[i].name = ps[i].name;
+                for (int d = 0; d < 7; ++d) snapshot[i].dayCount[d] = ps[i].dayCount[d];
+            }
+            writeBlock(fout, offset, sys_.rejectedCount(), snapshot);
+        }
+        if (!fout.flush()) { std::cerr << "Failed to write file: " << tmp << "\n"; return false; }
+    }
+    if (!replaceFile(tmp, checkpointPath_)) {
+        std::cerr << "Failed to write file: " << checkpointPath_ << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool CheckpointedLoader::loadFromFile(const std::string& path) {
+    std::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+    if (!fin.is_open()) { std::cerr << "Failed to open file: " << path << "\n"; return false; }
+    return loadFromStream(fin);
+}
+
+bool CheckpointedLoader::loadFromStream(std::istream& in) {
+    unsigned long long offset = 0;
+    if (!restore(in, offset)) return false;
+    resumedOffset_ = offset;
+    if (offset > 0) {
+        in.clear();
+        in.seekg((std::streamoff)offset);
+        if (!in) { std::cerr << "Failed to seek to checkpoint offset: " << offset << "\n"; return false; }
+    }
+
+    CheckpointWriter writer(checkpointPath_);
+    BlockDelta delta;
+    unsigned long long records = 0;
+    std::string name, day;
+    while (in >> name >> day) {
+        Weekday w;
+        if (parseWeekday(day, w)) {
+            int idx = sys_.addRecord(name, w);
+            if (idx >= 0) delta.add(idx, w); // 거부된 이름은 거부 수만 바뀜 (블록 머리의 누적값)
+        } else {
+            sys_.addRejected(1);
+        }
+        if (++records % interval_ != 0) continue;
+        std::streamoff pos = in.tellg();
+        if (pos < 0) continue;
+        writer.push(delta.take((unsigned long long)pos, sys_.rejectedCount(), sys_.players()));
+    }
+
+    // 입력 끝까지 반영한 마지막 체크포인트
+    in.clear();
+    in.seekg(0, std::ios::end);
+    std::streamoff end = in.tellg();
+    if (end >= 0) writer.push(delta.take((unsigned long long)end, sys_.rejectedCount(), sys_.players()));
+    if (!writer.finish()) { std::cerr << "Failed to write file: " << checkpointPath_ << "\n"; return false; }
+    return true;
+}
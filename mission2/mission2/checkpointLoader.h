@@ -0,0 +1,41 @@
+﻿#pragma once
+
+#include "attendance.h"
+
+#include <string>
+#include <iostream>
+
+// 체크포인트 기반 재시작 가능 입력
+// 일정 레코드마다 (입력 바이트 오프셋 + 직전 체크포인트 이후 변경분)을
+// 백그라운드 스레드가 체크포인트 파일 끝에 덧붙임. 재시작 시 마지막으로 온전히 기록된
+// 블록까지 상태를 복구하고 해당 오프셋부터 이어 읽으므로 중단 없는 실행과 결과가 같음.
+// 재시작 시 입력 크기와 앞부분 해시가 기록과 다르면 이어 읽지 않고 실패함
+// 파일 형식:
+//   ATTCKPT 2 <inputSize> <앞 4KB 해시>
+//   CKPT <offset> <entryCount> <rejected>   (블록 반복, rejected = offset까지 거부된 기록 수 누적)
+//   <playerIndex> <name> <mon> ... <sun>   (변경분, writePartialEntry 형식, name은 표시 이름)
+//   END <offset>
+class CheckpointedLoader {
+public:
+    // sys는 입력 시작 시 clear() 후 체크포인트 상태로 복구됨
+    CheckpointedLoader(AttendanceSystem& sys, const std::string& checkpointPath);
+
+    void setInterval(unsigned long long records); // 기본 100000 레코드마다
+
+    // 입력을 열 수 없거나 체크포인트를 기록하지 못했으면 false (sys에는 읽은 내용이 반영됨)
+    bool loadFromFile(const std::string& path);
+    bool loadFromStream(std::istream& in); // seekg/tellg 가능한 스트림
+
+    unsigned long long resumedOffset() const; // 복구한 위치 (0이면 처음부터)
+
+private:
+    AttendanceSystem& sys_;
+    std::string checkpointPath_;
+    unsigned long long interval_;
+    unsigned long long resumedOffset_;
+
+    bool restore(std::istream& in, unsigned long long& offset);
+
+    CheckpointedLoader(const CheckpointedLoader&);
+    CheckpointedLoader& operator=(const CheckpointedLoader&);
+};
@@ -0,0 +1,478 @@
+﻿#include "compressedInput.h"
+#include "multiFileLoader.h"
+#include "partialAggregate.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef ATTENDANCE_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef ATTENDANCE_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+
+// BGZF 블록 헤더(BC 추가 필드)면 블록 전체 크기, 아니면 0
+size_t bgzfBlockSize(const unsigned char* p, size_t n) {
+    if (n < 18 || p[0] != 0x1f || p[1] != 0x8b || p[2] != 8 || !(p[3] & 4)) return 0;
+    size_t xlen = p[10] | (p[11] << 8);
+    if (n < 12 + xlen) return 0;
+    for (size_t i = 12; i + 4 <= 12 + xlen;) {
+        size_t slen = p[i + 2] | (p[i + 3] << 8);
+        if (p[i] == 'B' && p[i + 1] == 'C' && slen == 2 && i + 6 <= 12 + xlen) return (size_t)(p[i + 4] | (p[i + 5] << 8)) + 1;
+        i += 4 + slen;
+    }
+    return 0;
+}
+
+CompressionFormat detectFormat(const unsigned char* p, size_t n) {
+    if (n >= 4 && p[0] == 0x28 && p[1] == 0xb5 && p[2] == 0x2f && p[3] == 0xfd) return Zstd;
+    if (n >= 3 && p[0] == 0x1f && p[1] == 0x8b && p[2] == 8) return bgzfBlockSize(p, n) ? Bgzf : Gzip;
+    return PlainText;
+}
+
+#ifdef ATTENDANCE_WITH_ZLIB
+// 이어 붙은 gzip 멤버들을 한 번에 해제
+bool inflateMembers(const std::vector<char>& in, size_t expected, std::vector<char>& out) {
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+    if (inflateInit2(&zs, 15 + 16) != Z_OK) return false;
+    zs.next_in = (Bytef*)(in.empty() ? 0 : &in[0]);
+    zs.avail_in = (uInt)in.size();
+    out.resize(expected > 0 ? expected : in.size() * 4);
+    size_t produced = 0;
+    bool ok = false;
+    for (;;) {
+        if (produced == out.size()) out.resize(out.size() * 2 + 4096);
+        zs.next_out = (Bytef*)&out[produced];
+        zs.avail_out = (uInt)(out.size() - produced);
+        int rc = inflate(&zs, Z_NO_FLUSH);
+        produced = out.size() - zs.avail_out;
+        if (rc == Z_STREAM_END) {
+            if (zs.avail_in == 0) { ok = true; break; }
+            inflateReset(&zs);
+        } else if (rc != Z_OK && !(rc == Z_BUF_ERROR && zs.avail_out == 0)) {
+            break; // 손상 또는 블록 안에서 잘린 멤버
+        }
+    }
+    out.resize(produced);
+    inflateEnd(&zs);
+    return ok;
+}
+#endif
+
+#ifdef ATTENDANCE_WITH_ZSTD
+const size_t kMaxFrameBytes = 64u << 20; // 이보다 큰 zstd 프레임(압축/해제 크기)은 순차 해제
+
+// 이어 붙은 zstd 프레임들을 한 번에 해제 (expected = 프레임 헤더의 내용 크기 합)
+bool decompressFrames(const std::vector<char>& in, size_t expected, std::vector<char>& out) {
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    if (!dctx) return false;
+    out.resize(expected);
+    size_t rc = ZSTD_decompressDCtx(dctx, out.empty() ? 0 : &out[0], out.size(), in.empty() ? 0 : &in[0], in.size());
+    ZSTD_freeDCtx(dctx);
+    bool ok = !ZSTD_isError(rc) && rc == expected;
+    out.resize(ok ? rc : 0);
+    return ok;
+}
+#endif
+
+} // namespace
+
+struct CompressedInput::Block {
+    std::vector<char> input;  // 압축 데이터 (이미 풀린 블록이면 비어 있음)
+    std::vector<char> output;
+    CompressionFormat format;
+    size_t expected;          // BGZF ISIZE 합 / zstd 프레임 내용 크기 합 (해제 버퍼 크기)
+    bool done, ok;
+    Block() : format(PlainText), expected(0), done(false), ok(true) {}
+};
+
+// 읽기 스레드의 입력 버퍼: 필요한 만큼만 파일에서 더 읽음
+struct CompressedInput::Window {
+    std::ifstream& file;
+    size_t chunk;
+    std::vector<char> data;
+    size_t pos;
+    bool eof;
+
+    Window(std::ifstream& f, size_t c) : file(f), chunk(c), pos(0), eof(false) {}
+    size_t avail() const { return data.size() - pos; }
+    const unsigned char* ptr() const { return data.empty() ? 0 : (const unsigned char*)&data[0] + pos; }
+    void consume(size_t n) { pos += n; }
+
+    bool ensure(size_t n) { // 최소 n 바이트 (파일 끝이면 false)
+        if (avail() >= n) return true;
+        if (pos > 0) { data.erase(data.begin(), data.begin() + pos); pos = 0; }
+        while (data.size() < n && !eof) {
+            size_t old = data.size();
+            size_t want = std::max(n - old, chunk);
+            data.resize(old + want);
+            file.read(&data[old], (std::streamsize)want);
+            size_t got = (size_t)file.gcount();
+            data.resize(old + got);
+            if (got < want) eof = true;
+        }
+        return avail() >= n;
+    }
+};
+
+CompressedInput::CompressedInput(int threads)
+    : threads_(threads), blockBytes_(1u << 20), format_(PlainText), window_(0),
+      readerDone_(true), stop_(false), failed_(false), in_(0) {}
+
+CompressedInput::~CompressedInput() { close(); }
+
+void CompressedInput::setBlockBytes(size_t bytes) { if (bytes > 0) blockBytes_ = bytes; }
+
+CompressionFormat CompressedInput::format() const { return format_; }
+
+bool CompressedInput::failed() const { return failed_; }
+
+bool CompressedInput::open(const std::string& path) {
+    close();
+    file_.open(path.c_str(), std::ios::in | std::ios::binary);
+    if (!file_.is_open()) { std::cerr << "Failed to open file: " << path << "\n"; return false; }
+    in_ = new Window(file_, blockBytes_);
+    in_->ensure(18);
+    format_ = detectFormat(in_->ptr(), in_->avail());
+#ifndef ATTENDANCE_WITH_ZLIB
+    if (format_ == Gzip || format_ == Bgzf) { std::cerr << "Unsupported compression format: " << path << "\n"; close(); return false; }
+#endif
+#ifndef ATTENDANCE_WITH_ZSTD
+    if (format_ == Zstd) { std::cerr << "Unsupported compression format: " << path << "\n"; close(); return false; }
+#endif
+
+    readerDone_ = false;
+    stop_ = false;
+    failed_ = false;
+    size_t n = threads_ > 0 ? (size_t)threads_ : (size_t)std::thread::hardware_concurrency();
+    if (n == 0) n = 1;
+    const bool parallel = (format_ == Bgzf || format_ == Zstd);
+    window_ = parallel ? n * 2 + 2 : 4; // 해제 중 + 소비 대기 블록 수 상한
+    if (parallel) for (size_t i = 0; i < n; ++i) workers_.push_back(std::thread(&CompressedInput::workerLoop, this));
+    reader_ = std::thread(&CompressedInput::readerLoop, this);
+    return true;
+}
+
+void CompressedInput::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (reader_.joinable()) reader_.join();
+    for (size_t i = 0; i < workers_.size(); ++i) workers_[i].join();
+    workers_.clear();
+    for (size_t i = 0; i < order_.size(); ++i) delete order_[i];
+    order_.clear();
+    todo_.clear();
+    readerDone_ = true;
+    delete in_;
+    in_ = 0;
+    if (file_.is_open()) file_.close();
+    file_.clear();
+}
+
+bool CompressedInput::read(std::vector<char>& block) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (failed_ || stop_) return false;
+    while (order_.empty() ? !readerDone_ : !order_.front()->done) cv_.wait(lock);
+    if (order_.empty()) return false;
+    Block* b = order_.front();
+    order_.pop_front();
+    cv_.notify_all(); // 읽기 스레드에 빈자리 알림
+    if (!b->ok) { failed_ = true; delete b; return false; }
+    block.swap(b->output);
+    if (spare_.size() < window_) { spare_.push_back(std::vector<char>()); spare_.back().swap(b->output); }
+    delete b;
+    return true;
+}
+
+bool CompressedInput::submit(Block* b) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_ && order_.size() >= window_) cv_.wait(lock);
+    if (stop_) { delete b; return false; }
+    order_.push_back(b);
+    if (!b->done) todo_.push_back(b);
+    cv_.notify_all();
+    return true;
+}
+
+std::vector<char> CompressedInput::takeSpare() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<char> v;
+    if (!spare_.empty()) { v.swap(spare_.back()); spare_.pop_back(); }
+    return v;
+}
+
+void CompressedInput::fail() {
+    Block* b = new Block();
+    b->done = true;
+    b->ok = false;
+    submit(b);
+}
+
+void CompressedInput::readerLoop() {
+    switch (format_) {
+    case Bgzf: readBgzf(); break;
+    case Zstd: readZstd(); break;
+    case Gzip: if (!inflateSequential()) fail(); break;
+    default: readPlain(); break;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        readerDone_ = true;
+    }
+    cv_.notify_all();
+}
+
+void CompressedInput::workerLoop() {
+    for (;;) {
+        Block* b;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!stop_ && todo_.empty() && !readerDone_) cv_.wait(lock);
+            if (stop_ || todo_.empty()) return;
+            b = todo_.front();
+            todo_.pop_front();
+        }
+        bool ok = false;
+#ifdef ATTENDANCE_WITH_ZLIB
+        if (b->format == Bgzf) ok = inflateMembers(b->input, b->expected, b->output);
+#endif
+#ifdef ATTENDANCE_WITH_ZSTD
+        if (b->format == Zstd) ok = decompressFrames(b->input, b->expected, b->output);
+#endif
+        std::vector<char>().swap(b->input);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            b->ok = ok;
+            b->done = true;
+        }
+        cv_.notify_all();
+    }
+}
+
+void CompressedInput::readPlain() {
+    for (;;) {
+        in_->ensure(blockBytes_);
+        if (in_->avail() == 0) return;
+        Block* b = new Block();
+        b->done = true;
+        b->output = takeSpare();
+        b->output.assign(in_->data.begin() + in_->pos, in_->data.end());
+        in_->consume(in_->avail());
+        if (!submit(b)) return;
+    }
+}
+
+void CompressedInput::readBgzf() {
+    Block* b = 0;
+    for (;;) {
+        if (!in_->ensure(12)) {
+            if (b && !submit(b)) return;
+            if (in_->avail() != 0) fail(); // 잘린 헤더
+            return;
+        }
+        size_t xlen = in_->ptr()[10] | (in_->ptr()[11] << 8);
+        size_t size = in_->ensure(12 + xlen) ? bgzfBlockSize(in_->ptr(), in_->avail()) : 0;
+        if (size == 0) {
+            // BGZF가 아닌 gzip 멤버가 이어짐: 지금까지의 블록을 보내고 나머지는 순차 해제
+            if (b && !submit(b)) return;
+            if (!inflateSequential()) fail();
+            return;
+        }
+        if (!in_->ensure(size)) {
+            if (b && !submit(b)) return;
+            fail(); // 잘린 블록
+            return;
+        }
+        if (!b) { b = new Block(); b->format = Bgzf; b->output = takeSpare(); }
+        const unsigned char* p = in_->ptr();
+        b->input.insert(b->input.end(), p, p + size);
+        b->expected += p[size - 4] | (p[size - 3] << 8) | (p[size - 2] << 16) | ((size_t)p[size - 1] << 24);
+        in_->consume(size);
+        if (b->input.size() >= blockBytes_) {
+            if (!submit(b)) return;
+            b = 0;
+        }
+    }
+}
+
+bool CompressedInput::inflateSequential() {
+#ifdef ATTENDANCE_WITH_ZLIB
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+    if (inflateInit2(&zs, 15 + 16) != Z_OK) return false;
+    bool ok = true, more = true, full = false;
+    Block* b = 0;
+    while (more) {
+        if (!b) {
+            b = new Block();
+            b->done = true;
+            b->output = takeSpare();
+            b->output.resize(blockBytes_);
+            zs.next_out = (Bytef*)&b->output[0];
+            zs.avail_out = (uInt)blockBytes_;
+        }
+        // 출력이 가득 차서 멈췄으면 입력 없이도 남은 출력을 더 꺼낼 수 있음
+        if (in_->avail() == 0 && !full && !in_->ensure(1)) { ok = false; break; } // 잘린 입력
+        zs.next_in = (Bytef*)in_->ptr();
+        zs.avail_in = (uInt)in_->avail();
+        int rc = inflate(&zs, Z_NO_FLUSH);
+        in_->consume(in_->avail() - zs.avail_in);
+        full = (zs.avail_out == 0);
+        if (rc == Z_STREAM_END) {
+            // 이어 붙은 다음 멤버가 있으면 계속 (그 외 꼬리 데이터는 gzip처럼 무시)
+            if (in_->ensure(2) && in_->ptr()[0] == 0x1f && in_->ptr()[1] == 0x8b) inflateReset(&zs);
+            else more = false;
+        } else if (rc != Z_OK && !(rc == Z_BUF_ERROR && (full || zs.avail_in == 0))) {
+            // Z_BUF_ERROR는 진행이 없다는 뜻일 뿐: 출력이 찼거나 입력 창이 비었으면 다음 바퀴에서 이어 감
+            ok = false;
+            break;
+        }
+        if (full || !more) {
+            b->output.resize(blockBytes_ - zs.avail_out);
+            bool sent = submit(b);
+            b = 0;
+            if (!sent) break;
+        }
+    }
+    if (b) {
+        b->output.resize(blockBytes_ - zs.avail_out);
+        submit(b); // 오류 전까지 풀린 내용
+    }
+    inflateEnd(&zs);
+    return ok;
+#else
+    return false;
+#endif
+}
+
+void CompressedInput::readZstd() {
+#ifdef ATTENDANCE_WITH_ZSTD
+    Block* b = 0;
+    for (;;) {
+        if (!in_->ensure(1)) break;
+        size_t size = ZSTD_findFrameCompressedSize(in_->ptr(), in_->avail());
+        while (ZSTD_isError(size) && !in_->eof && in_->avail() < kMaxFrameBytes) {
+            in_->ensure(in_->avail() + blockBytes_);
+            size = ZSTD_findFrameCompressedSize(in_->ptr(), in_->avail());
+        }
+        unsigned long long content = ZSTD_isError(size) ? 0 : ZSTD_getFrameContentSize(in_->ptr(), in_->avail());
+        if (ZSTD_isError(size) || content == ZSTD_CONTENTSIZE_ERROR || content == ZSTD_CONTENTSIZE_UNKNOWN || content > kMaxFrameBytes) {
+            // 내용 크기를 모르거나(스트리밍 압축) 너무 큰 프레임, 잘린 입력:
+            // 지금까지의 블록을 보내고 나머지는 순차 해제 (출력이 blockBytes 단위로 제한됨)
+            if (b && !submit(b)) return;
+            if (!decompressZstdSequential()) fail();
+            return;
+        }
+        if (!b) { b = new Block(); b->format = Zstd; b->output = takeSpare(); }
+        b->input.insert(b->input.end(), in_->ptr(), in_->ptr() + size);
+        b->expected += (size_t)content;
+        in_->consume(size);
+        if (b->input.size() >= blockBytes_ || b->expected >= kMaxFrameBytes) {
+            if (!submit(b)) return;
+            b = 0;
+        }
+    }
+    if (b) submit(b);
+#endif
+}
+
+bool CompressedInput::decompressZstdSequential() {
+#ifdef ATTENDANCE_WITH_ZSTD
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    if (!dctx) return false;
+    bool ok = true, full = false;
+    size_t rc = 0, produced = 0;
+    Block* b = 0;
+    for (;;) {
+        if (!b) {
+            b = new Block();
+            b->done = true;
+            b->output = takeSpare();
+            b->output.resize(blockBytes_);
+            produced = 0;
+        }
+        if (in_->avail() == 0 && !full && !in_->ensure(1)) { ok = (rc == 0); break; }
+        ZSTD_inBuffer ib = { in_->ptr(), in_->avail(), 0 };
+        ZSTD_outBuffer ob = { &b->output[0], b->output.size(), produced };
+        rc = ZSTD_decompressStream(dctx, &ob, &ib);
+        in_->consume(ib.pos);
+        produced = ob.pos;
+        if (ZSTD_isError(rc)) { ok = false; break; }
+        full = (produced == b->output.size());
+        if (full) {
+            bool sent = submit(b);
+            b = 0;
+            if (!sent) break;
+        }
+    }
+    if (b) {
+        b->output.resize(produced);
+        submit(b);
+    }
+    ZSTD_freeDCtx(dctx);
+    return ok;
+#else
+    return false;
+#endif
+}
+
+// CompressedStreamBuf
+CompressedStreamBuf::CompressedStreamBuf(int threads) : input_(threads) {}
+
+bool CompressedStreamBuf::open(const std::string& path) {
+    setg(0, 0, 0);
+    return input_.open(path);
+}
+
+bool CompressedStreamBuf::failed() const { return input_.failed(); }
+
+CompressedStreamBuf::int_type CompressedStreamBuf::underflow() {
+    if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+    while (input_.read(block_)) {
+        if (block_.empty()) continue; // 빈 멤버(BGZF EOF 표시 등)
+        setg(&block_[0], &block_[0], &block_[0] + block_.size());
+        return traits_type::to_int_type(block_[0]);
+    }
+    return traits_type::eof();
+}
+
+// CompressedLoader
+CompressedLoader::CompressedLoader(AttendanceSystem& sys) : sys_(sys), threads_(0), blockBytes_(0), lastFormat_(PlainText) {}
+
+void CompressedLoader::setThreadCount(int threads) { threads_ = threads > 0 ? threads : 0; }
+
+void CompressedLoader::setBlockBytes(size_t bytes) { blockBytes_ = bytes; }
+
+CompressionFormat CompressedLoader::lastFormat() const { return lastFormat_; }
+
+bool CompressedLoader::loadFromFile(const std::string& path) {
+    CompressedInput input(threads_);
+    if (blockBytes_ > 0) input.setBlockBytes(blockBytes_);
+    if (!input.open(path)) return false;
+    lastFormat_ = input.format();
+
+    // 블록 끝에서 잘린 레코드는 다음 블록 앞에 이어 붙여 파싱
+    std::vector<char> block, work;
+    PartialAggregate agg;
+    while (input.read(block)) {
+        if (work.empty()) work.swap(block);
+        else work.insert(work.end(), block.begin(), block.end());
+        if (work.empty()) continue;
+        size_t used = parseCompleteRecords(&work[0], work.size(), agg);
+        agg.applyTo(sys_);
+        agg.clear();
+        work.erase(work.begin(), work.begin() + used);
+    }
+    if (!work.empty()) {
+        parseRecords(&work[0], work.size(), agg);
+        agg.applyTo(sys_);
+    }
+    if (input.failed()) { std::cerr << "Failed to read file: " << path << "\n"; return false; }
+    return true;
+}
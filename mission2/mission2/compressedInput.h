@@ -0,0 +1,114 @@
+﻿#pragma once
+
+#include "attendance.h"
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 압축 로그 입력
+//   gzip  : ATTENDANCE_WITH_ZLIB 정의 + zlib 링크 시 지원 (여러 멤버를 이어 붙인 파일 포함)
+//   BGZF  : 블록마다 크기가 적힌 gzip(bgzip) -> 블록 단위 병렬 해제
+//   zstd  : ATTENDANCE_WITH_ZSTD 정의 + libzstd 링크 시 지원, 여러 프레임이면 프레임 단위 병렬 해제
+//           (내용 크기가 헤더에 없는 스트리밍 프레임이 나오면 그 뒤는 순차 해제)
+// VS 프로젝트에서는 AttendanceWithZlib / AttendanceWithZstd 속성으로 켬 (mission2.vcxproj 참고)
+//   그 외 : 압축되지 않은 텍스트로 그대로 통과
+enum CompressionFormat { PlainText, Gzip, Bgzf, Zstd };
+
+// 압축 파일을 풀린 순서대로 블록 단위로 돌려줌
+// 읽기 스레드가 압축 블록을 나누고 작업 스레드들이 병렬로 해제하며,
+// 해제 중/대기 중인 블록 수를 제한해 입력 크기와 무관하게 메모리가 일정함
+class CompressedInput {
+public:
+    explicit CompressedInput(int threads = 0); // 0 = 하드웨어 스레드 수
+    ~CompressedInput();
+
+    bool open(const std::string& path); // 열 수 없거나 이 빌드에서 지원하지 않는 형식이면 false
+    void close();
+
+    bool read(std::vector<char>& block); // 다음 블록 (끝이나 오류면 false, block 용량은 재사용됨)
+    bool failed() const;                 // 손상/잘린 입력
+    CompressionFormat format() const;
+
+    void setBlockBytes(size_t bytes); // 작업 하나의 압축 입력(순차 해제면 출력) 크기, 기본 1MB. open 전에 설정
+
+private:
+    struct Block;
+    struct Window;
+
+    int threads_;
+    size_t blockBytes_;
+    CompressionFormat format_;
+    std::ifstream file_;
+    std::thread reader_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Block*> order_;          // 읽은 순서 (앞에서부터 소비)
+    std::deque<Block*> todo_;           // 해제 대기
+    std::vector<std::vector<char> > spare_; // 소비자가 돌려준 버퍼 재사용
+    size_t window_;
+    bool readerDone_, stop_, failed_;
+
+    void readerLoop();
+    void workerLoop();
+    bool submit(Block* b);                 // 창이 찰 때까지 대기, 중단 시 false
+    std::vector<char> takeSpare();
+
+    void readPlain();
+    void readBgzf();
+    void readZstd();
+    bool inflateSequential();              // 나눌 수 없는 gzip은 읽기 스레드에서 순차 해제
+    bool decompressZstdSequential();
+    void fail();                           // 오류 블록을 넣어 소비자에게 알림
+
+    Window* in_;
+
+    CompressedInput(const CompressedInput&);
+    CompressedInput& operator=(const CompressedInput&);
+};
+
+// CompressedInput을 std::istream에서 쓰기 위한 streambuf
+//   CompressedStreamBuf buf; buf.open(path); std::istream in(&buf); sys.loadFromStream(in);
+class CompressedStreamBuf : public std::streambuf {
+public:
+    explicit CompressedStreamBuf(int threads = 0);
+
+    bool open(const std::string& path);
+    bool failed() const;
+
+protected:
+    virtual int_type underflow();
+
+private:
+    CompressedInput input_;
+    std::vector<char> block_;
+};
+
+// 압축/비압축 로그를 그대로 AttendanceSystem에 적재
+// 풀린 블록을 바로 파싱해 병합하므로 전체 평문을 메모리나 디스크에 만들지 않음
+class CompressedLoader {
+public:
+    explicit CompressedLoader(AttendanceSystem& sys);
+
+    void setThreadCount(int threads); // 해제 스레드 수, 0 = 하드웨어 스레드 수
+    void setBlockBytes(size_t bytes);  // CompressedInput::setBlockBytes, 0 = 기본값
+
+    bool loadFromFile(const std::string& path); // 열기 실패/손상 시 false (손상 전까지의 레코드는 반영됨)
+    CompressionFormat lastFormat() const;
+
+private:
+    AttendanceSystem& sys_;
+    int threads_;
+    size_t blockBytes_;
+    CompressionFormat lastFormat_;
+
+    CompressedLoader(const CompressedLoader&);
+    CompressedLoader& operator=(const CompressedLoader&);
+};
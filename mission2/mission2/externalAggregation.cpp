@@ -0,0 +1,426 @@
+﻿#include "externalAggregation.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <queue>
+#include <sstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const int kMaxSplitDepth = 8;   // 이름 하나가 예산보다 큰 경우 등 더 나눠도 줄지 않을 때의 한계
+const size_t kMaxSplitParts = 64;
+const size_t kMaxMergeFanIn = 128; // 동시에 여는 결과 파일 수 상한 (넘으면 중간 병합)
+
+// 시드마다 다른 파티션이 나오도록 FNV-1a 뒤에 섞음
+unsigned long long hashName(const std::string& s, unsigned seed) {
+    unsigned long long h = 1469598103934665603ULL; // FNV-1a
+    for (size_t i = 0; i < s.size(); ++i) { h ^= (unsigned char)s[i]; h *= 1099511628211ULL; }
+    h += seed * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 31; h *= 0xBF58476D1CE4E5B9ULL; h ^= h >> 29;
+    return h;
+}
+
+// 항목 하나가 메모리에서 차지하는 대략적인 크기
+// (PlayerStat 또는 map 노드 + PartialEntry 중 큰 쪽, 이름/등급 버퍼, 인덱스 슬롯, firstSeen 키)
+size_t estimateEntryBytes(const std::string& name) {
+    return sizeof(PlayerStat) + sizeof(std::string) + 64 + 2 * name.size();
+}
+
+bool makeDirectory(const std::string& path) {
+#ifdef _WIN32
+    return CreateDirectoryA(path.c_str(), 0) != 0;
+#else
+    return mkdir(path.c_str(), 0700) == 0;
+#endif
+}
+
+void removeDirectory(const std::string& path) {
+#ifdef _WIN32
+    RemoveDirectoryA(path.c_str());
+#else
+    rmdir(path.c_str());
+#endif
+}
+
+unsigned long processId() {
+#ifdef _WIN32
+    return (unsigned long)GetCurrentProcessId();
+#else
+    return (unsigned long)getpid();
+#endif
+}
+
+std::atomic<unsigned> g_tempDirSeq(0);
+
+// <prefix>.<pid>.<n> 디렉터리를 새로 만듦 (다른 프로세스/인스턴스와 겹치지 않음)
+bool makeTempDirectory(const std::string& prefix, std::string& out) {
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        std::ostringstream oss; oss << prefix << "." << processId() << "." << g_tempDirSeq++;
+        if (makeDirectory(oss.str())) { out = oss.str(); return true; }
+    }
+    std::cerr << "Failed to create directory: " << prefix << "\n";
+    return false;
+}
+
+// 결과 행: firstSeen d0..d6 base bonus total elim name grade
+void writeResult(std::ostream& os, unsigned long long firstSeen, const PlayerStat& p) {
+    os << firstSeen;
+    for (int d = 0; d < 7; ++d) os << ' ' << p.dayCount[d];
+    os << ' ' << p.basePoints << ' ' << p.bonusPoints << ' ' << p.totalPoints
+        << ' ' << (p.eliminationCandidate ? 1 : 0) << ' ' << p.name << ' ' << p.grade << '\n';
+}
+
+bool readResult(std::istream& in, unsigned long long& firstSeen, PlayerStat& p) {
+    int elim = 0;
+    if (!(in >> firstSeen)) return false;
+    for (int d = 0; d < 7; ++d) in >> p.dayCount[d];
+    in >> p.basePoints >> p.bonusPoints >> p.totalPoints >> elim >> p.name;
+    in.get();
+    std::getline(in, p.grade);
+    if (!in) return false;
+    p.eliminationCandidate = (elim != 0);
+    p.wedCount = p.dayCount[(int)Wed];
+    p.weekendCount = p.dayCount[(int)Sat] + p.dayCount[(int)Sun];
+    return true;
+}
+
+struct ResultItem {
+    unsigned long long firstSeen;
+    PlayerStat stat;
+    size_t source;
+};
+
+struct ResultGreater {
+    bool operator()(const ResultItem* a, const ResultItem* b) const { return a->firstSeen > b->firstSeen; }
+};
+
+// 병합된 결과를 firstSeen 순으로 받는 쪽
+struct ResultSink {
+    virtual ~ResultSink() {}
+    virtual void put(unsigned long long firstSeen, PlayerStat& p) = 0;
+};
+
+struct VisitorSink : public ResultSink {
+    explicit VisitorSink(IPlayerVisitor& v) : visitor(v), id(0) {}
+    virtual void put(unsigned long long, PlayerStat& p) { p.id = ++id; visitor.visit(p); }
+    IPlayerVisitor& visitor;
+    int id;
+};
+
+struct FileSink : public ResultSink {
+    explicit FileSink(std::ostream& o) : os(o) {}
+    virtual void put(unsigned long long firstSeen, PlayerStat& p) { writeResult(os, firstSeen, p); }
+    std::ostream& os;
+};
+
+// 결과 파일들을 firstSeen 순으로 k-way 병합
+bool mergeResults(const std::vector<std::string>& paths, size_t begin, size_t end, ResultSink& sink) {
+    std::vector<std::ifstream*> files;
+    std::vector<ResultItem> items(end - begin);
+    std::priority_queue<ResultItem*, std::vector<ResultItem*>, ResultGreater> heap;
+    bool ok = true;
+    for (size_t i = 0; i < items.size(); ++i) {
+        std::ifstream* f = new std::ifstream(paths[begin + i].c_str());
+        files.push_back(f);
+        if (!f->is_open()) { std::cerr << "Failed to open file: " << paths[begin + i] << "\n"; ok = false; break; }
+        items[i].source = i;
+        if (readResult(*f, items[i].firstSeen, items[i].stat)) heap.push(&items[i]);
+    }
+
+    while (ok && !heap.empty()) {
+        ResultItem* top = heap.top(); heap.pop();
+        sink.put(top->firstSeen, top->stat);
+        if (readResult(*files[top->source], top->firstSeen, top->stat)) heap.push(top);
+    }
+
+    for (size_t i = 0; i < files.size(); ++i) delete files[i];
+    return ok;
+}
+
+struct SummaryVisitor : public IPlayerVisitor {
+    explicit SummaryVisitor(std::ostream& o) : os(o) {}
+    virtual void visit(const PlayerStat& p) {
+        os << "NAME : " << p.name << ", POINT : " << p.totalPoints << ", GRADE : " << p.grade << "\n";
+    }
+    std::ostream& os;
+};
+
+struct RemovedVisitor : public IPlayerVisitor {
+    explicit RemovedVisitor(std::ostream& o) : os(o) {}
+    virtual void visit(const PlayerStat& p) { if (p.eliminationCandidate) os << p.name << "\n"; }
+    std::ostream& os;
+};
+
+} // namespace
+
+ExternalAttendanceAggregator::ExternalAttendanceAggregator()
+    : scoring_(0), grade_(0), elimination_(0),
+    ownScoring_(false), ownGrade_(false), ownElim_(false),
+    budget_(64u << 20), partitions_(16), prefix_("attendance_spill"),
+    pendingBytes_(0), recordSeq_(0), fileSeq_(0), inMemory_(0), playerCount_(0), peakBytes_(0), computed_(false)
+{
+    scoring_ = new DefaultScoringPolicy(); ownScoring_ = true;
+    grade_ = new ThresholdGradePolicy(); ownGrade_ = true;
+    elimination_ = new NormalNoWedWeekendElimination(); ownElim_ = true;
+}
+
+ExternalAttendanceAggregator::ExternalAttendanceAggregator(IScoringPolicy* s, IGradePolicy* g, IEliminationRule* e)
+    : scoring_(s), grade_(g), elimination_(e),
+    ownScoring_(false), ownGrade_(false), ownElim_(false),
+    budget_(64u << 20), partitions_(16), prefix_("attendance_spill"),
+    pendingBytes_(0), recordSeq_(0), fileSeq_(0), inMemory_(0), playerCount_(0), peakBytes_(0), computed_(false) {
+}
+
+ExternalAttendanceAggregator::~ExternalAttendanceAggregator() {
+    clear();
+    if (ownScoring_) delete scoring_;
+    if (ownGrade_)   delete grade_;
+    if (ownElim_)    delete elimination_;
+}
+
+void ExternalAttendanceAggregator::setMemoryBudget(size_t bytes) { budget_ = bytes; }
+
+void ExternalAttendanceAggregator::setPartitionCount(int partitions) { if (runs_.empty() && partitions > 0) partitions_ = partitions; }
+
+void ExternalAttendanceAggregator::setTempPrefix(const std::string& prefix) { if (runs_.empty()) prefix_ = prefix; }
+
+std::string ExternalAttendanceAggregator::tempPath(const char* ext) {
+    std::ostringstream oss; oss << dir_ << "/" << fileSeq_++ << ext;
+    return oss.str();
+}
+
+void ExternalAttendanceAggregator::addRecord(const std::string& name, Weekday day) {
+    size_t est = estimateEntryBytes(name);
+    if (pendingBytes_ > 0 && pendingBytes_ + est > budget_) spill(); // 넣기 전에 비워 예산을 넘지 않게
+    size_t before = pending_.size();
+    pending_.addRecord(name, day, recordSeq_++);
+    if (pending_.size() != before) pendingBytes_ += est;
+    peakBytes_ = std::max(peakBytes_, pendingBytes_);
+    computed_ = false;
+}
+
+bool ExternalAttendanceAggregator::addRecordLine(const std::string& nameToken, const std::string& dayToken) {
+    Weekday w; if (!parseWeekday(dayToken, w)) return false; addRecord(nameToken, w); return true;
+}
+
+void ExternalAttendanceAggregator::loadFromStream(std::istream& in) {
+    std::string name, day; while (in >> name >> day) { addRecordLine(name, day); }
+}
+
+bool ExternalAttendanceAggregator::loadFromFile(const std::string& path) {
+    std::ifstream fin(path.c_str()); if (!fin.is_open()) { std::cerr << "Failed to open file: " << path << "\n"; return false; }
+    loadFromStream(fin);
+    return true;
+}
+
+void ExternalAttendanceAggregator::spill() {
+    if (runs_.empty()) {
+        bool dirOk = !dir_.empty() || makeTempDirectory(prefix_, dir_);
+        for (int p = 0; p < partitions_; ++p) {
+            runPaths_.push_back(tempPath(".run"));
+            // 디렉터리를 못 만들면 열리지 않은 스트림 -> compute에서 쓰기 실패로 보고
+            runs_.push_back(dirOk ? new std::ofstream(runPaths_.back().c_str(), std::ios::out | std::ios::trunc) : new std::ofstream());
+        }
+    }
+    const std::vector<PartialEntry>& es = pending_.entries();
+    for (size_t i = 0; i < es.size(); ++i) writePartialEntry(*runs_[hashName(es[i].name, 0) % partitions_], es[i]);
+    pending_.clear();
+    pendingBytes_ = 0;
+}
+
+// 파티션 하나를 메모리에 올려 집계 -> 계산 -> firstSeen 순 결과 파일
+// 올리는 도중 예산을 넘으면 버리고 다음 시드로 다시 나눠 조각마다 반복
+bool ExternalAttendanceAggregator::computeRun(const std::string& path, int depth) {
+    std::ifstream fin(path.c_str()); if (!fin.is_open()) { std::cerr << "Failed to open file: " << path << "\n"; return false; }
+    size_t parts = 0;
+    {
+        AttendanceSystem sys(scoring_, grade_, elimination_);
+        std::vector<unsigned long long> keys; // 플레이어 인덱스 -> firstSeen
+        size_t bytes = 0;
+        PartialEntry e;
+        while (readPartialEntry(fin, e)) {
+            size_t est = estimateEntryBytes(e.name);
+            if (bytes + est > budget_ && depth < kMaxSplitDepth && sys.indexOf(e.name) < 0) {
+                // 읽은 비율로 파티션 전체 크기를 추정해 예산 단위로 나눔
+                std::streamoff readPos = fin.tellg();
+                fin.seekg(0, std::ios::end);
+                double projected = (double)bytes * (double)fin.tellg() / (double)std::max<std::streamoff>(readPos, 1);
+                parts = (size_t)(projected / (double)std::max<size_t>(budget_, 1)) + 1;
+                parts = std::min(kMaxSplitParts, std::max((size_t)2, parts));
+                break;
+            }
+            int idx = sys.addDayCounts(e.name, e.dayCount);
+            if (idx < 0) continue;
+            if ((size_t)idx == keys.size()) { keys.push_back(e.firstSeen); bytes += est; }
+            else if (e.firstSeen < keys[idx]) keys[idx] = e.firstSeen;
+        }
+        peakBytes_ = std::max(peakBytes_, bytes);
+
+        if (parts == 0) {
+            sys.compute();
+            std::vector<size_t> order(keys.size());
+            for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+            std::sort(order.begin(), order.end(), [&keys](size_t x, size_t y) { return keys[x] < keys[y]; });
+
+            results_.push_back(tempPath(".res"));
+            std::ofstream fout(results_.back().c_str()); if (!fout.is_open()) { std::cerr << "Failed to open file: " << results_.back() << "\n"; return false; }
+            const PlayerList ps = sys.players();
+            for (size_t i = 0; i < order.size(); ++i) writeResult(fout, keys[order[i]], ps[order[i]]);
+            if (!fout) { std::cerr << "Failed to write file: " << results_.back() << "\n"; return false; }
+            playerCount_ += ps.size();
+            return true;
+        }
+    } // 다시 나누기 전에 올려 둔 항목을 해제
+    return splitRun(fin, path, depth, parts);
+}
+
+bool ExternalAttendanceAggregator::splitRun(std::ifstream& fin, const std::string& path, int depth, size_t parts) {
+    std::vector<std::string> paths;
+    {
+        std::vector<std::ofstream*> outs;
+        for (size_t i = 0; i < parts; ++i) {
+            paths.push_back(tempPath(".run"));
+            outs.push_back(new std::ofstream(paths.back().c_str(), std::ios::out | std::ios::trunc));
+        }
+        fin.clear();
+        fin.seekg(0);
+        PartialEntry e;
+        while (readPartialEntry(fin, e)) writePartialEntry(*outs[hashName(e.name, (unsigned)depth + 1) % parts], e);
+        bool ok = true;
+        for (size_t i = 0; i < parts; ++i) {
+            outs[i]->flush();
+            if (!*outs[i]) { std::cerr << "Failed to write file: " << paths[i] << "\n"; ok = false; }
+            delete outs[i];
+        }
+        if (!ok) {
+            for (size_t i = 0; i < parts; ++i) std::remove(paths[i].c_str());
+            return false;
+        }
+    }
+    fin.close();
+    if (depth > 0) std::remove(path.c_str()); // 최상위 파티션은 이후 입력이 이어 쓰므로 유지
+
+    bool ok = true;
+    for (size_t i = 0; i < parts; ++i) {
+        ok = ok && computeRun(paths[i], depth + 1);
+        std::remove(paths[i].c_str());
+    }
+    return ok;
+}
+
+void ExternalAttendanceAggregator::removeResults() {
+    for (size_t i = 0; i < results_.size(); ++i) std::remove(results_[i].c_str());
+    results_.clear();
+}
+
+bool ExternalAttendanceAggregator::compute() {
+    delete inMemory_; inMemory_ = 0;
+    playerCount_ = 0;
+    computed_ = false;
+
+    if (runs_.empty()) {
+        inMemory_ = new AttendanceSystem(scoring_, grade_, elimination_);
+        pending_.applyTo(*inMemory_);
+        inMemory_->compute();
+        playerCount_ = inMemory_->players().size();
+        computed_ = true;
+        return true;
+    }
+
+    spill();
+    for (size_t p = 0; p < runs_.size(); ++p) {
+        runs_[p]->flush();
+        if (!*runs_[p]) { std::cerr << "Failed to write file: " << runPaths_[p] << "\n"; return false; }
+    }
+
+    removeResults();
+    for (size_t p = 0; p < runPaths_.size(); ++p) {
+        if (!computeRun(runPaths_[p], 0)) { removeResults(); playerCount_ = 0; return false; }
+    }
+    if (!mergeResultsToFanIn()) { removeResults(); playerCount_ = 0; return false; }
+    computed_ = true;
+    return true;
+}
+
+// 결과 파일이 너무 많으면 kMaxMergeFanIn개씩 미리 병합 (출력 때 한 번에 열 파일 수 제한)
+bool ExternalAttendanceAggregator::mergeResultsToFanIn() {
+    while (results_.size() > kMaxMergeFanIn) {
+        std::vector<std::string> next;
+        for (size_t begin = 0; begin < results_.size(); begin += kMaxMergeFanIn) {
+            size_t end = std::min(results_.size(), begin + kMaxMergeFanIn);
+            if (end - begin == 1) { next.push_back(results_[begin]); continue; }
+            next.push_back(tempPath(".res"));
+            std::ofstream fout(next.back().c_str());
+            FileSink sink(fout);
+            bool ok = fout.is_open() && mergeResults(results_, begin, end, sink) && (bool)fout;
+            if (!ok) std::cerr << "Failed to write file: " << next.back() << "\n";
+            for (size_t i = begin; i < end; ++i) std::remove(results_[i].c_str());
+            if (!ok) {
+                results_.erase(results_.begin(), results_.begin() + end);
+                results_.insert(results_.end(), next.begin(), next.end());
+                return false;
+            }
+        }
+        results_.swap(next);
+    }
+    return true;
+}
+
+bool ExternalAttendanceAggregator::forEachPlayer(IPlayerVisitor& visitor) const {
+    if (!computed_) return false;
+    if (inMemory_) {
+        const PlayerList ps = inMemory_->players();
+        for (size_t i = 0; i < ps.size(); ++i) visitor.visit(ps[i]);
+        return true;
+    }
+
+    // 파티션 결과를 firstSeen 순으로 k-way 병합하며 ID 부여
+    VisitorSink sink(visitor);
+    return mergeResults(results_, 0, results_.size(), sink);
+}
+
+bool ExternalAttendanceAggregator::printSummary(std::ostream& os) const {
+    SummaryVisitor summary(os);
+    if (!forEachPlayer(summary)) return false;
+    os << "\nRemoved player\n==============\n";
+    RemovedVisitor removed(os);
+    return forEachPlayer(removed);
+}
+
+bool ExternalAttendanceAggregator::spilled() const { return !runs_.empty(); }
+
+size_t ExternalAttendanceAggregator::playerCount() const { return playerCount_; }
+
+size_t ExternalAttendanceAggregator::peakResidentBytes() const { return peakBytes_; }
+
+void ExternalAttendanceAggregator::closeRuns() {
+    for (size_t p = 0; p < runs_.size(); ++p) {
+        delete runs_[p];
+        std::remove(runPaths_[p].c_str());
+    }
+    runs_.clear();
+    runPaths_.clear();
+    removeResults();
+    if (!dir_.empty()) { removeDirectory(dir_); dir_.clear(); }
+    fileSeq_ = 0;
+}
+
+void ExternalAttendanceAggregator::clear() {
+    closeRuns();
+    pending_.clear();
+    pendingBytes_ = 0;
+    recordSeq_ = 0;
+    delete inMemory_; inMemory_ = 0;
+    playerCount_ = 0;
+    peakBytes_ = 0;
+    computed_ = false;
+}
@@ -0,0 +1,91 @@
+﻿#pragma once
+
+#include "attendance.h"
+#include "partialAggregate.h"
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+// 집계 결과를 한 명씩 받는 쪽 (ID 순서로 호출됨)
+struct IPlayerVisitor {
+    virtual ~IPlayerVisitor() {}
+    virtual void visit(const PlayerStat& p) = 0;
+};
+
+// 외부 메모리 집계: 서로 다른 이름 수가 메모리 예산을 넘으면
+// 이름 해시로 파티션을 나눠 디스크에 내려 쓰고(spill), 파티션별로 집계/계산한 뒤
+// 최초 등장 순서(firstSeen) k-way 병합으로 ID 순서를 복원해 출력함
+// 적재 중 예산을 넘는 파티션은 다른 해시 시드로 (읽은 양 기준 추정 크기 / 예산)개로 다시 나눔
+// -> 메모리에 동시에 올라가는 항목은 이름 수와 관계없이 예산 이하
+class ExternalAttendanceAggregator {
+public:
+    ExternalAttendanceAggregator(); // 기본 정책 장착
+
+    // 전략 주입 생성자 (소유권은 호출자가 가짐)
+    ExternalAttendanceAggregator(IScoringPolicy* scoring,
+        IGradePolicy* grade,
+        IEliminationRule* elimination);
+
+    ~ExternalAttendanceAggregator();
+
+    // Config (입력 전에 설정)
+    void setMemoryBudget(size_t bytes);            // 기본 64MB
+    void setPartitionCount(int partitions);        // 첫 spill 파티션 수, 기본 16
+    void setTempPrefix(const std::string& prefix); // 임시 디렉터리 <prefix>.<pid>.<n>, 기본 "attendance_spill"
+
+    // Input
+    void addRecord(const std::string& name, Weekday day);
+    bool addRecordLine(const std::string& nameToken, const std::string& dayToken);
+    void loadFromStream(std::istream& in);
+    bool loadFromFile(const std::string& path); // 열 수 없으면 false
+
+    // Compute
+    bool compute();
+
+    // Output
+    bool forEachPlayer(IPlayerVisitor& visitor) const;
+    bool printSummary(std::ostream& os) const;
+    bool spilled() const;
+    size_t playerCount() const;
+    size_t peakResidentBytes() const; // 메모리에 올렸던 항목의 추정 크기 최대값
+
+    // Utils
+    void clear(); // 임시 파일/디렉터리 삭제
+
+private:
+    IScoringPolicy* scoring_;
+    IGradePolicy* grade_;
+    IEliminationRule* elimination_;
+
+    bool ownScoring_, ownGrade_, ownElim_;
+
+    size_t budget_;
+    int partitions_;
+    std::string prefix_;
+
+    PartialAggregate pending_;        // 아직 내려 쓰지 않은 집계
+    size_t pendingBytes_;
+    unsigned long long recordSeq_;    // 전역 레코드 순번 = firstSeen 키
+
+    std::string dir_;                  // 프로세스별 임시 디렉터리 (첫 spill 때 생성)
+    unsigned fileSeq_;
+    std::vector<std::ofstream*> runs_; // 파티션별 spill 파일
+    std::vector<std::string> runPaths_;
+    std::vector<std::string> results_; // 파티션(또는 재분할 조각)별 결과, firstSeen 순
+    AttendanceSystem* inMemory_;       // spill 없이 끝난 경우
+    size_t playerCount_;
+    size_t peakBytes_;
+    bool computed_;
+
+    void spill();
+    bool computeRun(const std::string& path, int depth);
+    bool splitRun(std::ifstream& fin, const std::string& path, int depth, size_t parts);
+    bool mergeResultsToFanIn();
+    void removeResults();
+    void closeRuns();
+    std::string tempPath(const char* ext);
+
+    ExternalAttendanceAggregator(const ExternalAttendanceAggregator&);
+    ExternalAttendanceAggregator& operator=(const ExternalAttendanceAggregator&);
+};
@@ -0,0 +1,98 @@
+﻿#include "groupHierarchy.h"
+#include <fstream>
+#include <sstream>
+
+GroupHierarchy::GroupHierarchy() : rejected_(0) {}
+
+int GroupHierarchy::addGroup(const std::string& name, int parent) {
+    std::unordered_map<std::string, int>::const_iterator it = groupIndex_.find(name);
+    if (it != groupIndex_.end()) return it->second;
+    if (parent < -1 || parent >= (int)names_.size()) return -1;
+    int id = (int)names_.size();
+    names_.push_back(name);
+    parent_.push_back(parent);
+    groupIndex_[name] = id;
+    return id;
+}
+
+bool GroupHierarchy::assign(const std::string& member, int group) {
+    if (group < 0 || group >= (int)names_.size()) return false;
+    std::unordered_map<std::string, int>::const_iterator it = memberIndex_.find(member);
+    if (it != memberIndex_.end()) { memberGroup_[it->second] = group; return true; }
+    memberIndex_[member] = (int)members_.size();
+    members_.push_back(member);
+    memberGroup_.push_back(group);
+    return true;
+}
+
+bool GroupHierarchy::addLine(const std::string& line) {
+    if (parseLine(line)) return true;
+    ++rejected_;
+    return false;
+}
+
+bool GroupHierarchy::parseLine(const std::string& line) {
+    std::istringstream iss(line);
+    std::string kind, name, target, extra;
+    if (!(iss >> kind) || kind[0] == '#') return true; // 빈 줄/주석
+    if (!(iss >> name)) return false;
+    bool hasTarget = (bool)(iss >> target);
+    if (iss >> extra) return false;
+    if (kind == "group") {
+        int parent = hasTarget ? findGroup(target) : -1;
+        if (hasTarget && parent < 0) return false;
+        int id = findGroup(name);
+        if (id >= 0) return parentOf(id) == parent; // 같은 선언 반복만 허용
+        return addGroup(name, parent) >= 0;
+    }
+    if (kind == "member" && hasTarget) return assign(name, findGroup(target));
+    return false;
+}
+
+bool GroupHierarchy::loadFromStream(std::istream& in) {
+    size_t before = rejected_;
+    std::string line;
+    while (std::getline(in, line)) addLine(line);
+    return rejected_ == before;
+}
+
+bool GroupHierarchy::loadFromFile(const std::string& path) {
+    std::ifstream fin(path.c_str()); if (!fin.is_open()) { std::cerr << "Failed to open file: " << path << "\n"; return false; }
+    size_t before = rejected_;
+    if (!loadFromStream(fin)) std::cerr << "Rejected " << (rejected_ - before) << " line(s) in: " << path << "\n";
+    return true;
+}
+
+int GroupHierarchy::groupCount() const { return (int)names_.size(); }
+
+int GroupHierarchy::findGroup(const std::string& name) const {
+    std::unordered_map<std::string, int>::const_iterator it = groupIndex_.find(name);
+    return it == groupIndex_.end() ? -1 : it->second;
+}
+
+const std::string& GroupHierarchy::groupName(int group) const { return names_[group]; }
+
+int GroupHierarchy::parentOf(int group) const { return parent_[group]; }
+
+int GroupHierarchy::groupOf(const std::string& member) const {
+    std::unordered_map<std::string, int>::const_iterator it = memberIndex_.find(member);
+    return it == memberIndex_.end() ? -1 : memberGroup_[it->second];
+}
+
+size_t GroupHierarchy::memberCount() const { return members_.size(); }
+
+const std::string& GroupHierarchy::memberName(size_t i) const { return members_[i]; }
+
+int GroupHierarchy::memberGroup(size_t i) const { return memberGroup_[i]; }
+
+size_t GroupHierarchy::rejectedLines() const { return rejected_; }
+
+void GroupHierarchy::clear() {
+    names_.clear();
+    parent_.clear();
+    members_.clear();
+    memberGroup_.clear();
+    groupIndex_.clear();
+    memberIndex_.clear();
+    rejected_ = 0;
+}
@@ -0,0 +1,48 @@
+﻿#pragma once
+
+#include <iostream>
+#include <unordered_map>
+#include <string>
+#include <vector>
+
+// 조직도 (멤버 -> 팀 -> 부서 ...)
+// 그룹은 추가 순서대로 0부터 정수 id를 받고, 상위 그룹은 하위 그룹보다 먼저 추가해야 함
+// (parent id < child id 이므로 뒤에서부터 한 번 훑으면 하위 합계가 상위로 올라감)
+// 파일 형식 (공백 구분, 한 줄에 하나, '#'으로 시작하면 주석):
+//   group <그룹> [상위그룹]
+//   member <이름> <그룹>
+class GroupHierarchy {
+public:
+    GroupHierarchy();
+
+    // Input
+    int addGroup(const std::string& name, int parent = -1); // 그룹 id, 상위 그룹이 없으면 -1 (이미 있으면 기존 id)
+    bool assign(const std::string& member, int group);      // 다시 지정하면 마지막 값
+    bool addLine(const std::string& line);                  // 형식이 틀리거나 모르는 그룹이면 false
+    bool loadFromStream(std::istream& in);                  // 거부된 줄이 있으면 false (나머지 줄은 반영)
+    bool loadFromFile(const std::string& path);             // 열 수 없으면 false, 거부된 줄은 개수만 경고
+
+    // Output
+    int groupCount() const;
+    int findGroup(const std::string& name) const;   // 없으면 -1
+    const std::string& groupName(int group) const;
+    int parentOf(int group) const;                  // 최상위면 -1
+    int groupOf(const std::string& member) const;   // 소속이 없으면 -1
+    size_t memberCount() const;
+    const std::string& memberName(size_t i) const;  // 처음 지정된 순서
+    int memberGroup(size_t i) const;
+    size_t rejectedLines() const;                   // addLine/load에서 거부된 줄 수 (clear 전까지 누적)
+
+    void clear();
+
+private:
+    std::vector<std::string>   names_;
+    std::vector<int>           parent_;
+    std::vector<std::string>   members_;
+    std::vector<int>           memberGroup_;   // members_와 같은 순서
+    std::unordered_map<std::string, int> groupIndex_;  // 그룹 이름 -> id
+    std::unordered_map<std::string, int> memberIndex_; // 멤버 이름 -> members_ 위치
+    size_t                     rejected_;
+
+    bool parseLine(const std::string& line);
+};
@@ -1,10 +1,216 @@
 ﻿#include "attendance.h"
+#include "partialAggregate.h"
+#include "externalAggregation.h"
+#include "checkpointLoader.h"
+#include "approximateAttendance.h"
+#include "multiFileLoader.h"
+#include "batchScheduler.h"
+#include "compressedInput.h"
+#include "groupHierarchy.h"
+#include "resultExport.h"
+#include "nameNormalizer.h"
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 #ifndef _ENABLE_GTEST
 
-int main() {
+// 사용법
+//   mission2                                         : attendance_weekday_500.txt 처리
+//   mission2 --partial <log> <out> [keyBase]         : 로그 -> 부분 집계본 (keyBase = 앞선 사이트들의 기록 수 합)
+//   mission2 --merge-partials <out> <part>...        : 부분 집계본 병합 -> 부분 집계본
+//   mission2 --merge <part>...                       : 부분 집계본 병합 -> compute -> 출력
+//   mission2 --external <log> <budgetBytes>          : 메모리 예산 초과 시 디스크 spill 집계
+//   mission2 --checkpointed <log> <checkpoint>       : 체크포인트 기록, 중단 시 이어서 처리
+//   mission2 --approximate <log>                     : 고정 메모리 근사 요약
+//   mission2 --files <log>...                        : 여러 로그를 병렬로 읽어 목록 순서대로 병합
+//   mission2 --dir <dir> [suffix]                    : 디렉터리의 로그를 파일명 순으로 병합
+//   mission2 --compressed <log>...                   : gzip/bgzip/zstd 로그를 풀면서 바로 적재 (비압축도 가능)
+//   mission2 --rollup <log> <orgchart>               : 플레이어 요약 + 팀/부서별 등급 분포, 점수 합, 탈락 수
+//   mission2 --export <log> <csv|jsonl|bin> <out> [columns] [partitions]
+//                                                    : 전체 결과 내보내기 (columns 예: id,name,total / partitions>1이면 out은 접두어)
+//   mission2 --normalized <log>                      : 이름 정규화(대소문자/NFC) 후 처리, 거부된 기록 수는 stderr
+//   mission2 --batch <manifest> [threads]            : 테넌트별 "<이름> <출력> <로그>..." 줄을 한 번에 처리
+static int runPartial(int argc, char** argv) {
+    if (argc < 4) { std::cerr << "usage: --partial <log> <out> [keyBase]\n"; return 2; }
+    unsigned long long keyBase = (argc > 4) ? std::strtoull(argv[4], 0, 10) : 0;
+    std::ifstream fin(argv[2]); if (!fin.is_open()) { std::cerr << "Failed to open file: " << argv[2] << "\n"; return 1; }
+    AttendanceSystem sys;
+    sys.loadFromStream(fin);
+    return PartialAggregate::fromSystem(sys, keyBase).saveToFile(argv[3]) ? 0 : 1;
+}
+
+static int runMergePartials(int argc, char** argv) {
+    if (argc < 4) { std::cerr << "usage: --merge-partials <out> <part>...\n"; return 2; }
+    std::ofstream fout(argv[2]); if (!fout.is_open()) { std::cerr << "Failed to open file: " << argv[2] << "\n"; return 1; }
+    std::vector<std::string> paths(argv + 3, argv + argc);
+    return mergePartialFiles(paths, fout) ? 0 : 1;
+}
+
+static int runMerge(int argc, char** argv) {
+    if (argc < 3) { std::cerr << "usage: --merge <part>...\n"; return 2; }
+    std::vector<std::string> paths(argv + 2, argv + argc);
+    PartialAggregate merged;
+    if (!mergePartialFiles(paths, merged)) return 1;
+    AttendanceSystem sys;
+    merged.applyTo(sys);
+    sys.compute();
+    sys.printSummary(std::cout);
+    return 0;
+}
+
+static int runExternal(int argc, char** argv) {
+    if (argc < 4) { std::cerr << "usage: --external <log> <budgetBytes>\n"; return 2; }
+    ExternalAttendanceAggregator ext;
+    ext.setMemoryBudget((size_t)std::strtoull(argv[3], 0, 10));
+    if (!ext.loadFromFile(argv[2])) return 1;
+    if (!ext.compute()) return 1;
+    return ext.printSummary(std::cout) ? 0 : 1;
+}
+
+static int runCheckpointed(int argc, char** argv) {
+    if (argc < 4) { std::cerr << "usage: --checkpointed <log> <checkpoint>\n"; return 2; }
+    AttendanceSystem sys;
+    CheckpointedLoader loader(sys, argv[3]);
+    if (!loader.loadFromFile(argv[2])) return 1;
+    sys.compute();
+    sys.printSummary(std::cout);
+    return 0;
+}
+
+static int runApproximate(int argc, char** argv) {
+    if (argc < 3) { std::cerr << "usage: --approximate <log>\n"; return 2; }
+    static const char* dayNames[] = { "monday", "tuesday", "wednesday", "thursday", "friday", "saturday", "sunday" };
+    ApproximateAttendance approx;
+    if (!approx.loadFromFile(argv[2])) return 1;
+    std::cout << "RECORDS : " << approx.recordCount() << ", PLAYERS(EST) : " << (long long)(approx.estimateDistinctPlayers() + 0.5) << "\n";
+    std::vector<GradeEstimate> bands = approx.estimateGradeBands();
+    for (size_t i = 0; i < bands.size(); ++i) std::cout << "GRADE : " << bands[i].gradeName << ", PLAYERS(EST) : " << (long long)(bands[i].players + 0.5) << "\n";
+    for (int d = 0; d < 7; ++d) {
+        std::vector<HeavyHitter> top = approx.topAttendees((Weekday)d);
+        if (!top.empty()) std::cout << "TOP " << dayNames[d] << " : " << top[0].name << " (" << top[0].estimate << ")\n";
+    }
+    return 0;
+}
+
+static int runFiles(int argc, char** argv) {
+    std::string mode = argv[1];
+    if (argc < 3) { std::cerr << "usage: --files <log>... | --dir <dir> [suffix]\n"; return 2; }
+    AttendanceSystem sys;
+    MultiFileLoader loader(sys);
+    bool ok = (mode == "--dir")
+        ? loader.loadFromDirectory(argv[2], argc > 3 ? argv[3] : ".txt")
+        : loader.loadFromFiles(std::vector<std::string>(argv + 2, argv + argc));
+    sys.compute();
+    sys.printSummary(std::cout);
+    return ok ? 0 : 1;
+}
+
+static int runCompressed(int argc, char** argv) {
+    if (argc < 3) { std::cerr << "usage: --compressed <log>...\n"; return 2; }
+    AttendanceSystem sys;
+    CompressedLoader loader(sys);
+    bool ok = true;
+    for (int i = 2; i < argc; ++i) ok = loader.loadFromFile(argv[i]) && ok;
+    sys.compute();
+    sys.printSummary(std::cout);
+    return ok ? 0 : 1;
+}
+
+static int runRollup(int argc, char** argv) {
+    if (argc < 4) { std::cerr << "usage: --rollup <log> <orgchart>\n"; return 2; }
+    GroupHierarchy org;
+    if (!org.loadFromFile(argv[3])) return 1;
+    std::ifstream fin(argv[2]); if (!fin.is_open()) { std::cerr << "Failed to open file: " << argv[2] << "\n"; return 1; }
+    AttendanceSystem sys;
+    sys.setHierarchy(&org);
+    sys.loadFromStream(fin);
+    sys.compute();
+    sys.printSummary(std::cout);
+    std::cout << "\nGroup rollup\n============\n";
+    sys.printRollup(std::cout);
+    return 0;
+}
+
+static int runExport(int argc, char** argv) {
+    if (argc < 5) { std::cerr << "usage: --export <log> <csv|jsonl|bin> <out> [columns] [partitions]\n"; return 2; }
+    CsvResultWriter csv;
+    JsonLinesResultWriter jsonl;
+    ColumnarBinaryResultWriter bin;
+    std::string format = argv[3];
+    const IResultWriter* writer = (format == "csv") ? (const IResultWriter*)&csv
+        : (format == "jsonl") ? (const IResultWriter*)&jsonl
+        : (format == "bin") ? (const IResultWriter*)&bin : 0;
+    if (!writer) { std::cerr << "Unknown format: " << format << "\n"; return 2; }
+    ColumnMask cols = AllColumns;
+    if (argc > 5 && !parseColumnList(argv[5], cols)) { std::cerr << "Unknown column in: " << argv[5] << "\n"; return 2; }
+    size_t partitions = (argc > 6) ? (size_t)std::strtoul(argv[6], 0, 10) : 1;
+
+    std::ifstream fin(argv[2]); if (!fin.is_open()) { std::cerr << "Failed to open file: " << argv[2] << "\n"; return 1; }
+    AttendanceSystem sys;
+    sys.loadFromStream(fin);
+    sys.compute();
+    ResultExporter exporter(sys);
+    exporter.setColumns(cols);
+    bool ok = (partitions > 1) ? exporter.exportPartitioned(argv[4], partitions, *writer) : exporter.exportToFile(argv[4], *writer);
+    return ok ? 0 : 1;
+}
+
+static int runNormalized(int argc, char** argv) {
+    if (argc < 3) { std::cerr << "usage: --normalized <log>\n"; return 2; }
+    std::ifstream fin(argv[2]); if (!fin.is_open()) { std::cerr << "Failed to open file: " << argv[2] << "\n"; return 1; }
+    DefaultNameNormalizer normalizer;
+    AttendanceSystem sys;
+    sys.setNameNormalizer(&normalizer);
+    sys.loadFromStream(fin);
+    sys.compute();
+    sys.printSummary(std::cout);
+    std::cerr << "Rejected records: " << sys.rejectedCount() << "\n";
+    return 0;
+}
+
+static int runBatch(int argc, char** argv) {
+    if (argc < 3) { std::cerr << "usage: --batch <manifest> [threads]\n"; return 2; }
+    std::ifstream fin(argv[2]); if (!fin.is_open()) { std::cerr << "Failed to open file: " << argv[2] << "\n"; return 1; }
+    BatchScheduler batch(argc > 3 ? std::atoi(argv[3]) : 0);
+    bool added = true;
+    std::string line;
+    while (std::getline(fin, line)) {
+        std::istringstream iss(line);
+        TenantJob job;
+        std::string input;
+        if (!(iss >> job.name >> job.outputPath)) continue;
+        while (iss >> input) job.inputs.push_back(input);
+        added = batch.addTenant(job) && added;
+    }
+    bool ok = batch.run() && added;
+    for (size_t i = 0; i < batch.results().size(); ++i) {
+        const TenantResult& r = batch.results()[i];
+        std::cout << "TENANT : " << r.name << ", PLAYERS : " << r.players << ", SECONDS : " << r.seconds << (r.ok ? "" : ", FAILED") << "\n";
+    }
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        std::string mode = argv[1];
+        if (mode == "--partial") return runPartial(argc, argv);
+        if (mode == "--merge-partials") return runMergePartials(argc, argv);
+        if (mode == "--merge") return runMerge(argc, argv);
+        if (mode == "--external") return runExternal(argc, argv);
+        if (mode == "--checkpointed") return runCheckpointed(argc, argv);
+        if (mode == "--approximate") return runApproximate(argc, argv);
+        if (mode == "--files" || mode == "--dir") return runFiles(argc, argv);
+        if (mode == "--compressed") return runCompressed(argc, argv);
+        if (mode == "--rollup") return runRollup(argc, argv);
+        if (mode == "--export") return runExport(argc, argv);
+        if (mode == "--normalized") return runNormalized(argc, argv);
+        if (mode == "--batch") return runBatch(argc, argv);
+        std::cerr << "Unknown option: " << mode << "\n";
+        return 2;
+    }
+
     AttendanceSystem sys;
     sys.loadFromFile("attendance_weekday_500.txt");
     sys.compute();
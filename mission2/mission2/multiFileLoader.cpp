@@ -0,0 +1,236 @@
+﻿#include "multiFileLoader.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+bool equalsLower(const char* s, size_t n, const char* lower) {
+    size_t len = std::strlen(lower);
+    if (n != len) return false;
+    for (size_t i = 0; i < n; ++i) {
+        char c = s[i];
+        if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        if (c != lower[i]) return false;
+    }
+    return true;
+}
+
+// parseWeekday와 같은 규칙, 문자열 생성 없이 비교
+bool parseWeekdayToken(const char* s, size_t n, Weekday& out) {
+    static const char* names[] = { "monday", "tuesday", "wednesday", "thursday", "friday", "saturday", "sunday" };
+    for (int d = 0; d < 7; ++d) {
+        if (equalsLower(s, n, names[d])) { out = (Weekday)d; return true; }
+    }
+    return false;
+}
+
+struct FileSlot {
+    PartialAggregate agg;
+    size_t bytes; // 예약한 버퍼 크기 (파일 크기)
+    bool done;
+    bool ok;
+    FileSlot() : bytes(0), done(false), ok(false) {}
+};
+
+// final이 아니면 버퍼 끝에서 잘렸을 수 있는 마지막 레코드(이름/요일 쌍)는 처리하지 않고 남김
+// 버퍼 안에서는 이름별 요일 카운터에 모으고 끝에서 이름마다 한 번만 out에 넘김
+size_t parsePairs(const char* data, size_t size, PartialAggregate& out, bool final) {
+    const char* p = data;
+    const char* end = data + size;
+    const char* consumed = data;
+    unsigned long long seq = 0;
+    std::string name;
+    std::unordered_map<std::string, size_t> slotByName; // 이름 -> local 위치
+    std::vector<PartialEntry> local;                     // 버퍼 안 첫 등장 순서
+    size_t rejected = 0;
+    for (;;) {
+        while (p < end && isSpace(*p)) ++p;
+        const char* nameBegin = p;
+        while (p < end && !isSpace(*p)) ++p;
+        const char* nameEnd = p;
+        while (p < end && isSpace(*p)) ++p;
+        const char* dayBegin = p;
+        while (p < end && !isSpace(*p)) ++p;
+        if (dayBegin == p) break; // 짝이 맞지 않는 마지막 토큰은 무시
+        if (!final && p == end) { consumed = nameBegin; break; }
+        consumed = p;
+        Weekday w;
+        if (!parseWeekdayToken(dayBegin, (size_t)(p - dayBegin), w)) { ++rejected; continue; }
+        name.assign(nameBegin, nameEnd);
+        std::unordered_map<std::string, size_t>::iterator it = slotByName.find(name);
+        if (it == slotByName.end()) {
+            it = slotByName.insert(std::make_pair(name, local.size())).first;
+            local.push_back(PartialEntry());
+            local.back().firstSeen = seq;
+            local.back().name = name;
+        }
+        ++local[it->second].dayCount[(int)w];
+        ++seq;
+    }
+    for (size_t i = 0; i < local.size(); ++i) out.addEntry(local[i]);
+    out.addRejected(rejected);
+    return (size_t)(consumed - data);
+}
+
+} // namespace
+
+void parseRecords(const char* data, size_t size, PartialAggregate& out) {
+    parsePairs(data, size, out, true);
+}
+
+size_t parseCompleteRecords(const char* data, size_t size, PartialAggregate& out) {
+    return parsePairs(data, size, out, false);
+}
+
+bool readWholeFile(const std::string& path, std::vector<char>& buf) {
+    std::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+    if (!fin.is_open()) return false;
+    fin.seekg(0, std::ios::end);
+    std::streamoff size = fin.tellg();
+    if (size < 0) return false;
+    fin.seekg(0, std::ios::beg);
+    buf.resize((size_t)size);
+    if (size > 0) fin.read(&buf[0], size);
+    return fin.gcount() == size;
+}
+
+bool listDirectory(const std::string& dir, const std::string& suffix, std::vector<std::string>& out) {
+    std::vector<std::string> names;
+#ifdef _WIN32
+    WIN32_FIND_DATAA fd;
+    HANDLE h = FindFirstFileA((dir + "\\*").c_str(), &fd);
+    if (h == INVALID_HANDLE_VALUE) { std::cerr << "Failed to open directory: " << dir << "\n"; return false; }
+    do {
+        if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) names.push_back(fd.cFileName);
+    } while (FindNextFileA(h, &fd));
+    FindClose(h);
+    const std::string sep = "\\";
+#else
+    DIR* d = opendir(dir.c_str());
+    if (!d) { std::cerr << "Failed to open directory: " << dir << "\n"; return false; }
+    while (struct dirent* e = readdir(d)) {
+        std::string full = dir + "/" + e->d_name;
+        struct stat st;
+        if (stat(full.c_str(), &st) == 0 && S_ISREG(st.st_mode)) names.push_back(e->d_name);
+    }
+    closedir(d);
+    const std::string sep = "/";
+#endif
+    std::sort(names.begin(), names.end());
+    for (size_t i = 0; i < names.size(); ++i) {
+        const std::string& n = names[i];
+        if (n.size() >= suffix.size() && n.compare(n.size() - suffix.size(), suffix.size(), suffix) == 0) out.push_back(dir + sep + n);
+    }
+    return true;
+}
+
+MultiFileLoader::MultiFileLoader(AttendanceSystem& sys) : sys_(sys), threads_(0), budget_(256u << 20), failed_(0), peakBytes_(0) {}
+
+void MultiFileLoader::setThreadCount(int threads) { threads_ = threads > 0 ? threads : 0; }
+
+void MultiFileLoader::setMemoryBudget(size_t bytes) { if (bytes > 0) budget_ = bytes; }
+
+size_t MultiFileLoader::failedFiles() const { return failed_; }
+
+size_t MultiFileLoader::peakBufferedBytes() const { return peakBytes_; }
+
+bool MultiFileLoader::loadFromFiles(const std::vector<std::string>& paths) {
+    failed_ = 0;
+    peakBytes_ = 0;
+    if (paths.empty()) return true;
+
+    size_t workers = threads_ > 0 ? (size_t)threads_ : (size_t)std::thread::hardware_concurrency();
+    if (workers == 0) workers = 1;
+    workers = std::min(workers, paths.size());
+    const size_t keepBuffer = budget_ / workers; // 이보다 큰 스레드 버퍼는 파일마다 반납
+
+    std::vector<FileSlot> slots(paths.size());
+    std::mutex mutex;
+    std::condition_variable doneCv, windowCv;
+    size_t nextFile = 0, merged = 0;
+    size_t reserved = 0; // 읽는 중이거나 병합 대기 중인 파일 크기 합
+
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < workers; ++t) {
+        pool.push_back(std::thread([&]() {
+            std::vector<char> buf; // 스레드마다 재사용
+            for (;;) {
+                size_t i;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (nextFile >= paths.size()) return;
+                    i = nextFile++;
+                }
+                // 예산 안에서만 읽음. 가장 앞의 미병합 파일은 예산과 관계없이 진행 (병합이 멈추지 않도록)
+                std::ifstream fin(paths[i].c_str(), std::ios::in | std::ios::binary);
+                fin.seekg(0, std::ios::end);
+                std::streamoff size = fin.is_open() ? (std::streamoff)fin.tellg() : -1;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    slots[i].bytes = size > 0 ? (size_t)size : 0;
+                    while (i != merged && reserved + slots[i].bytes > budget_) windowCv.wait(lock);
+                    reserved += slots[i].bytes;
+                    peakBytes_ = std::max(peakBytes_, reserved);
+                }
+                bool ok = size >= 0;
+                if (ok) {
+                    fin.seekg(0, std::ios::beg);
+                    buf.resize((size_t)size);
+                    if (size > 0) fin.read(&buf[0], size);
+                    ok = fin.gcount() == size;
+                }
+                if (ok && !buf.empty()) parseRecords(&buf[0], buf.size(), slots[i].agg);
+                if (buf.capacity() > keepBuffer) std::vector<char>().swap(buf);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slots[i].ok = ok;
+                    slots[i].done = true;
+                }
+                doneCv.notify_all();
+            }
+        }));
+    }
+
+    // 목록 순서대로 병합 -> 최초 등장 순서(ID) 보존
+    for (size_t i = 0; i < paths.size(); ++i) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!slots[i].done) doneCv.wait(lock);
+        }
+        if (slots[i].ok) slots[i].agg.applyTo(sys_);
+        else { std::cerr << "Failed to open file: " << paths[i] << "\n"; ++failed_; }
+        slots[i].agg.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            merged = i + 1;
+            reserved -= slots[i].bytes;
+        }
+        windowCv.notify_all();
+    }
+
+    for (size_t t = 0; t < pool.size(); ++t) pool[t].join();
+    return failed_ == 0;
+}
+
+bool MultiFileLoader::loadFromDirectory(const std::string& dir, const std::string& suffix) {
+    std::vector<std::string> paths;
+    if (!listDirectory(dir, suffix, paths)) return false;
+    return loadFromFiles(paths);
+}
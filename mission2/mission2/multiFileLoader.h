@@ -0,0 +1,50 @@
+﻿#pragma once
+
+#include "attendance.h"
+#include "partialAggregate.h"
+
+#include <string>
+#include <vector>
+
+// 여러 로그 파일(사이트/일자별)을 작업 스레드들이 병렬로 읽고 파싱하며,
+// 호출 스레드는 끝난 파일부터 목록 순서대로 병합함 (읽기/파싱과 병합이 겹침)
+// 결과는 파일을 목록 순서대로 loadFromFile 한 것과 같음
+// 읽어 둔(읽는 중 + 병합 대기) 파일 크기 합은 메모리 예산 이하로 제한. 단 가장 앞의 미병합 파일은
+// 예산을 넘어도 진행하므로 상한은 예산 + 가장 큰 파일 하나
+class MultiFileLoader {
+public:
+    explicit MultiFileLoader(AttendanceSystem& sys);
+
+    void setThreadCount(int threads); // 0 = 하드웨어 스레드 수
+    void setMemoryBudget(size_t bytes); // 동시에 버퍼에 둘 파일 바이트 수, 기본 256MB
+
+    bool loadFromFiles(const std::vector<std::string>& paths); // 열지 못한 파일이 있으면 false
+    bool loadFromDirectory(const std::string& dir, const std::string& suffix = ".txt"); // 파일명 순
+
+    size_t failedFiles() const;
+    size_t peakBufferedBytes() const; // 마지막 load에서 동시에 예약된 파일 크기 합의 최대값
+
+private:
+    AttendanceSystem& sys_;
+    int threads_;
+    size_t budget_;
+    size_t failed_;
+    size_t peakBytes_;
+
+    MultiFileLoader(const MultiFileLoader&);
+    MultiFileLoader& operator=(const MultiFileLoader&);
+};
+
+// dir 안에서 suffix로 끝나는 일반 파일 경로를 이름 순으로 수집
+bool listDirectory(const std::string& dir, const std::string& suffix, std::vector<std::string>& out);
+
+// 메모리 버퍼를 loadFromStream과 같은 규칙(공백 구분 이름/요일 쌍)으로 파싱
+// firstSeen은 버퍼 안에서의 레코드 순번
+void parseRecords(const char* data, size_t size, PartialAggregate& out);
+
+// 스트림을 버퍼 단위로 나눠 파싱할 때 사용: 끝에서 잘렸을 수 있는 레코드는 남기고
+// 처리한 바이트 수를 돌려줌 (나머지를 다음 버퍼 앞에 붙여 다시 호출)
+size_t parseCompleteRecords(const char* data, size_t size, PartialAggregate& out);
+
+// 파일 전체를 buf에 읽음 (buf 용량은 재사용)
+bool readWholeFile(const std::string& path, std::vector<char>& buf);
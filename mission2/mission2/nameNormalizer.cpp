@@ -0,0 +1,155 @@
+﻿#include "nameNormalizer.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ATTENDANCE_HAVE_SSE2 1
+#endif
+
+namespace {
+
+// 앞에서부터 ASCII(최상위 비트 0)인 바이트 수
+size_t asciiPrefix(const unsigned char* p, size_t n) {
+    size_t i = 0;
+#ifdef ATTENDANCE_HAVE_SSE2
+    for (; i + 16 <= n; i += 16) {
+        if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(p + i))) != 0) break;
+    }
+#else
+    for (; i + 8 <= n; i += 8) {
+        unsigned long long w;
+        std::memcpy(&w, p + i, 8);
+        if (w & 0x8080808080808080ull) break;
+    }
+#endif
+    while (i < n && p[i] < 0x80) ++i;
+    return i;
+}
+
+// p[i]에서 코드 포인트 하나를 읽고 i를 넘김. 잘못된 바이트열이면 false
+bool decodeUtf8(const unsigned char* p, size_t n, size_t& i, unsigned& cp) {
+    unsigned c = p[i];
+    if (c < 0x80) { cp = c; ++i; return true; }
+    size_t len;
+    unsigned min;
+    if (c >= 0xC2 && c <= 0xDF) { len = 2; cp = c & 0x1F; min = 0x80; }
+    else if (c >= 0xE0 && c <= 0xEF) { len = 3; cp = c & 0x0F; min = 0x800; }
+    else if (c >= 0xF0 && c <= 0xF4) { len = 4; cp = c & 0x07; min = 0x10000; }
+    else return false; // 연속 바이트로 시작, C0/C1, F5 이상
+    if (i + len > n) return false;
+    for (size_t k = 1; k < len; ++k) {
+        unsigned cc = p[i + k];
+        if ((cc & 0xC0) != 0x80) return false;
+        cp = (cp << 6) | (cc & 0x3F);
+    }
+    if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return false;
+    i += len;
+    return true;
+}
+
+void appendUtf8(std::string& out, unsigned cp) {
+    if (cp < 0x80) { out += (char)cp; return; }
+    if (cp < 0x800) { out += (char)(0xC0 | (cp >> 6)); }
+    else if (cp < 0x10000) { out += (char)(0xE0 | (cp >> 12)); out += (char)(0x80 | ((cp >> 6) & 0x3F)); }
+    else { out += (char)(0xF0 | (cp >> 18)); out += (char)(0x80 | ((cp >> 12) & 0x3F)); out += (char)(0x80 | ((cp >> 6) & 0x3F)); }
+    out += (char)(0x80 | (cp & 0x3F));
+}
+
+unsigned foldCase(unsigned cp) {
+    if (cp < 0x80) return (cp >= 'A' && cp <= 'Z') ? cp + 32 : cp;
+    if (cp >= 0xC0 && cp <= 0xDE && cp != 0xD7) return cp + 32;              // Latin-1 (× 제외)
+    if ((cp >= 0x100 && cp <= 0x12F) || (cp >= 0x132 && cp <= 0x137) ||
+        (cp >= 0x14A && cp <= 0x177)) return cp | 1;                          // 짝수 = 대문자
+    if ((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17E)) return (cp & 1) ? cp + 1 : cp; // 홀수 = 대문자
+    if (cp == 0x178) return 0xFF;
+    return cp;
+}
+
+struct Composition {
+    unsigned short base, mark, composed;
+};
+
+// 소문자 기본 문자 + 결합 부호 (대문자는 foldCase 후 소문자로 들어옴)
+const Composition kLatin[] = {
+    { 'a', 0x300, 0xE0 }, { 'e', 0x300, 0xE8 }, { 'i', 0x300, 0xEC }, { 'o', 0x300, 0xF2 }, { 'u', 0x300, 0xF9 },
+    { 'a', 0x301, 0xE1 }, { 'e', 0x301, 0xE9 }, { 'i', 0x301, 0xED }, { 'o', 0x301, 0xF3 }, { 'u', 0x301, 0xFA },
+    { 'y', 0x301, 0xFD }, { 'c', 0x301, 0x107 }, { 'n', 0x301, 0x144 }, { 's', 0x301, 0x15B }, { 'z', 0x301, 0x17A },
+    { 'a', 0x302, 0xE2 }, { 'e', 0x302, 0xEA }, { 'i', 0x302, 0xEE }, { 'o', 0x302, 0xF4 }, { 'u', 0x302, 0xFB },
+    { 'a', 0x303, 0xE3 }, { 'n', 0x303, 0xF1 }, { 'o', 0x303, 0xF5 },
+    { 'a', 0x308, 0xE4 }, { 'e', 0x308, 0xEB }, { 'i', 0x308, 0xEF }, { 'o', 0x308, 0xF6 }, { 'u', 0x308, 0xFC },
+    { 'y', 0x308, 0xFF },
+    { 'a', 0x30A, 0xE5 }, { 'u', 0x30A, 0x16F },
+    { 'c', 0x30C, 0x10D }, { 'e', 0x30C, 0x11B }, { 'n', 0x30C, 0x148 }, { 'r', 0x30C, 0x159 }, { 's', 0x30C, 0x161 },
+    { 'z', 0x30C, 0x17E },
+    { 'c', 0x327, 0xE7 }, { 's', 0x327, 0x15F },
+};
+
+// 한글 음절 조합 상수 (유니코드 표준 3.12)
+const unsigned SBase = 0xAC00, LBase = 0x1100, VBase = 0x1161, TBase = 0x11A7;
+const unsigned LCount = 19, VCount = 21, TCount = 28, SCount = LCount * VCount * TCount;
+
+// last 뒤에 cp가 오면 합쳐지는 코드 포인트, 없으면 0
+unsigned compose(unsigned last, unsigned cp) {
+    if (cp >= 0x300 && cp < 0x370) {
+        for (size_t k = 0; k < sizeof(kLatin) / sizeof(kLatin[0]); ++k) {
+            if (kLatin[k].base == last && kLatin[k].mark == cp) return kLatin[k].composed;
+        }
+        return 0;
+    }
+    if (last >= LBase && last < LBase + LCount && cp >= VBase && cp < VBase + VCount)
+        return SBase + ((last - LBase) * VCount + (cp - VBase)) * TCount;   // 초성 + 중성
+    if (last >= SBase && last < SBase + SCount && (last - SBase) % TCount == 0 && cp > TBase && cp < TBase + TCount)
+        return last + (cp - TBase);                                          // 초중성 음절 + 종성
+    return 0;
+}
+
+} // namespace
+
+bool isValidUtf8(const char* data, size_t size) {
+    const unsigned char* p = (const unsigned char*)data;
+    size_t i = 0;
+    for (;;) {
+        i += asciiPrefix(p + i, size - i);
+        if (i >= size) return true;
+        unsigned cp;
+        if (!decodeUtf8(p, size, i, cp)) return false;
+    }
+}
+
+bool DefaultNameNormalizer::normalize(const std::string& name, std::string& key) const {
+    const unsigned char* p = (const unsigned char*)name.data();
+    const size_t n = name.size();
+    key.clear();
+    if (n == 0) return false;
+
+    // 빠른 경로: ASCII 구간은 소문자 복사만
+    const size_t ascii = asciiPrefix(p, n);
+    for (size_t i = 0; i < ascii; ++i) {
+        unsigned char c = p[i];
+        if (c < 0x20 || c == 0x7F) return false; // 제어 문자
+        key += (char)((c >= 'A' && c <= 'Z') ? c + 32 : c);
+    }
+    if (ascii == n) return true;
+
+    bool hasLast = ascii > 0;
+    unsigned last = hasLast ? (unsigned)(unsigned char)key[ascii - 1] : 0;
+    size_t lastPos = hasLast ? ascii - 1 : 0;
+    for (size_t i = ascii; i < n;) {
+        unsigned cp;
+        if (!decodeUtf8(p, n, i, cp)) return false;
+        if (cp < 0x20 || (cp >= 0x7F && cp < 0xA0)) return false; // C0/DEL/C1 제어 문자
+        cp = foldCase(cp);
+        unsigned composed = hasLast ? compose(last, cp) : 0;
+        if (composed) {
+            key.resize(lastPos);
+            appendUtf8(key, composed);
+            last = composed;
+            continue;
+        }
+        lastPos = key.size();
+        appendUtf8(key, cp);
+        last = cp;
+        hasLast = true;
+    }
+    return true;
+}
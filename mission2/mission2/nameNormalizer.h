@@ -0,0 +1,18 @@
+﻿#pragma once
+
+#include "attendance.h"
+
+#include <string>
+
+// 기본 이름 정규화
+//   1) UTF-8 검증: 잘못된 바이트열, overlong, 서로게이트, 제어 문자가 있으면 거부
+//   2) 대소문자 통일: ASCII, Latin-1, Latin Extended-A 대문자 -> 소문자
+//   3) NFC 빠른 경로: 한글 첫가끝 자모 -> 완성형 음절, 라틴 기본 문자 + 흔한 결합 부호 -> 조합형
+// 모두 ASCII인 이름(대부분)은 16바이트 단위로 확인하고 소문자 복사만 함
+class DefaultNameNormalizer : public INameNormalizer {
+public:
+    virtual bool normalize(const std::string& name, std::string& key) const;
+};
+
+// 올바른 UTF-8인지 (ASCII 구간은 SIMD/8바이트 단위로 건너뜀)
+bool isValidUtf8(const char* data, size_t size);
@@ -0,0 +1,225 @@
+﻿#include "partialAggregate.h"
+#include <algorithm>
+#include <fstream>
+#include <queue>
+
+namespace {
+
+bool lessByName(const PartialEntry* a, const PartialEntry* b) { return a->name < b->name; }
+
+bool lessByFirstSeen(const PartialEntry* a, const PartialEntry* b) {
+    if (a->firstSeen != b->firstSeen) return a->firstSeen < b->firstSeen;
+    return a->name < b->name;
+}
+
+void accumulate(PartialEntry& dst, const PartialEntry& src) {
+    for (int d = 0; d < 7; ++d) dst.dayCount[d] += src.dayCount[d];
+    if (src.firstSeen < dst.firstSeen) dst.firstSeen = src.firstSeen;
+}
+
+// 병합 결과를 받는 쪽 (파일 또는 메모리)
+struct PartialSink {
+    virtual ~PartialSink() {}
+    virtual void begin(size_t rejected) = 0; // 모든 입력의 머리를 읽은 뒤 한 번
+    virtual void put(const PartialEntry& e) = 0;
+};
+
+struct StreamSink : public PartialSink {
+    explicit StreamSink(std::ostream& o) : os(o) {}
+    virtual void begin(size_t rejected) { writePartialHeader(os, rejected); }
+    virtual void put(const PartialEntry& e) { writePartialEntry(os, e); }
+    std::ostream& os;
+};
+
+struct AggregateSink : public PartialSink {
+    explicit AggregateSink(PartialAggregate& a) : agg(a) {}
+    virtual void begin(size_t rejected) { agg.addRejected(rejected); }
+    virtual void put(const PartialEntry& e) { agg.addEntry(e); }
+    PartialAggregate& agg;
+};
+
+struct HeapItem {
+    PartialEntry entry;
+    size_t source;
+};
+
+struct HeapGreater {
+    bool operator()(const HeapItem* a, const HeapItem* b) const {
+        if (a->entry.name != b->entry.name) return a->entry.name > b->entry.name;
+        return a->source > b->source;
+    }
+};
+
+bool kWayMerge(const std::vector<std::string>& paths, PartialSink& sink) {
+    std::vector<std::ifstream*> files;
+    std::vector<PartialReader*> readers;
+    std::vector<HeapItem> items(paths.size());
+    std::priority_queue<HeapItem*, std::vector<HeapItem*>, HeapGreater> heap;
+    bool ok = true;
+    size_t rejected = 0;
+
+    for (size_t i = 0; i < paths.size(); ++i) {
+        std::ifstream* f = new std::ifstream(paths[i].c_str());
+        files.push_back(f);
+        readers.push_back(new PartialReader(*f));
+        if (!f->is_open()) { std::cerr << "Failed to open file: " << paths[i] << "\n"; ok = false; break; }
+        if (!readers[i]->ok()) { std::cerr << "Invalid partial file: " << paths[i] << "\n"; ok = false; break; }
+        rejected += readers[i]->rejectedCount();
+        items[i].source = i;
+        if (readers[i]->next(items[i].entry)) heap.push(&items[i]);
+    }
+    if (ok) sink.begin(rejected);
+
+    bool hasCur = false;
+    PartialEntry cur;
+    while (ok && !heap.empty()) {
+        HeapItem* top = heap.top(); heap.pop();
+        if (hasCur && cur.name == top->entry.name) {
+            accumulate(cur, top->entry);
+        } else {
+            if (hasCur) sink.put(cur);
+            cur = top->entry; hasCur = true;
+        }
+        if (readers[top->source]->next(top->entry)) heap.push(top);
+    }
+    if (ok && hasCur) sink.put(cur);
+
+    for (size_t i = 0; i < readers.size(); ++i) {
+        if (ok && readers[i]->failed()) { std::cerr << "Invalid partial file: " << paths[i] << "\n"; ok = false; }
+        delete readers[i];
+        delete files[i];
+    }
+    return ok;
+}
+
+} // namespace
+
+// PartialAggregate
+PartialAggregate::PartialAggregate() : rejected_(0) {}
+
+void PartialAggregate::addRecord(const std::string& name, Weekday day, unsigned long long firstSeen) {
+    PartialEntry e; e.firstSeen = firstSeen; e.name = name; e.dayCount[(int)day] = 1;
+    addEntry(e);
+}
+
+void PartialAggregate::addEntry(const PartialEntry& e) {
+    std::map<std::string, int>::iterator it = indexByName_.find(e.name);
+    if (it != indexByName_.end()) { accumulate(entries_[it->second], e); return; }
+    indexByName_.insert(std::make_pair(e.name, (int)entries_.size()));
+    entries_.push_back(e);
+}
+
+void PartialAggregate::addRejected(size_t records) { rejected_ += records; }
+
+void PartialAggregate::merge(const PartialAggregate& other) {
+    for (size_t i = 0; i < other.entries_.size(); ++i) addEntry(other.entries_[i]);
+    rejected_ += other.rejected_;
+}
+
+PartialAggregate PartialAggregate::fromSystem(const AttendanceSystem& sys, unsigned long long keyBase) {
+    PartialAggregate out;
+    const PlayerList ps = sys.players();
+    for (size_t i = 0; i < ps.size(); ++i) {
+        PartialEntry e; e.firstSeen = keyBase + i; e.name = ps[i].name;
+        for (int d = 0; d < 7; ++d) e.dayCount[d] = ps[i].dayCount[d];
+        out.addEntry(e);
+    }
+    out.rejected_ = sys.rejectedCount();
+    return out;
+}
+
+void PartialAggregate::applyTo(AttendanceSystem& sys) const {
+    std::vector<const PartialEntry*> order;
+    order.reserve(entries_.size());
+    for (size_t i = 0; i < entries_.size(); ++i) order.push_back(&entries_[i]);
+    std::stable_sort(order.begin(), order.end(), lessByFirstSeen);
+    for (size_t i = 0; i < order.size(); ++i) {
+        sys.addDayCounts(order[i]->name, order[i]->dayCount);
+    }
+    sys.addRejected(rejected_);
+}
+
+void PartialAggregate::save(std::ostream& os) const {
+    std::vector<const PartialEntry*> order;
+    order.reserve(entries_.size());
+    for (size_t i = 0; i < entries_.size(); ++i) order.push_back(&entries_[i]);
+    std::sort(order.begin(), order.end(), lessByName);
+    writePartialHeader(os, rejected_);
+    for (size_t i = 0; i < order.size(); ++i) writePartialEntry(os, *order[i]);
+}
+
+bool PartialAggregate::load(std::istream& in) {
+    PartialReader r(in);
+    if (!r.ok()) return false;
+    rejected_ += r.rejectedCount();
+    PartialEntry e;
+    while (r.next(e)) addEntry(e);
+    return !r.failed();
+}
+
+bool PartialAggregate::saveToFile(const std::string& path) const {
+    std::ofstream fout(path.c_str()); if (!fout.is_open()) { std::cerr << "Failed to open file: " << path << "\n"; return false; }
+    save(fout);
+    return (bool)fout;
+}
+
+bool PartialAggregate::loadFromFile(const std::string& path) {
+    std::ifstream fin(path.c_str()); if (!fin.is_open()) { std::cerr << "Failed to open file: " << path << "\n"; return false; }
+    return load(fin);
+}
+
+const std::vector<PartialEntry>& PartialAggregate::entries() const { return entries_; }
+
+size_t PartialAggregate::size() const { return entries_.size(); }
+
+size_t PartialAggregate::rejectedCount() const { return rejected_; }
+
+void PartialAggregate::clear() { indexByName_.clear(); entries_.clear(); rejected_ = 0; }
+
+// PartialReader
+PartialReader::PartialReader(std::istream& in) : in_(in), ok_(false), failed_(false), rejected_(0), hasLast_(false) {
+    std::string magic; int version = 0;
+    if (in_ >> magic >> version) ok_ = (magic == "ATTPART" && (version == 1 || (version == 2 && in_ >> rejected_)));
+    failed_ = !ok_;
+}
+
+bool PartialReader::ok() const { return ok_; }
+
+bool PartialReader::failed() const { return failed_; }
+
+size_t PartialReader::rejectedCount() const { return rejected_; }
+
+bool PartialReader::next(PartialEntry& out) {
+    if (failed_) return false;
+    in_ >> std::ws;
+    if (in_.eof()) return false;
+    if (!readPartialEntry(in_, out)) { failed_ = true; return false; }
+    if (hasLast_ && !(lastName_ < out.name)) { failed_ = true; return false; }
+    lastName_ = out.name; hasLast_ = true;
+    return true;
+}
+
+void writePartialHeader(std::ostream& os, size_t rejected) { os << "ATTPART 2 " << rejected << "\n"; }
+
+void writePartialEntry(std::ostream& os, const PartialEntry& e) {
+    os << e.firstSeen << ' ' << e.name;
+    for (int d = 0; d < 7; ++d) os << ' ' << e.dayCount[d];
+    os << '\n';
+}
+
+bool readPartialEntry(std::istream& in, PartialEntry& out) {
+    if (!(in >> out.firstSeen)) return false;
+    in >> out.name;
+    for (int d = 0; d < 7; ++d) in >> out.dayCount[d];
+    return (bool)in;
+}
+
+bool mergePartialFiles(const std::vector<std::string>& paths, std::ostream& out) {
+    StreamSink sink(out);
+    return kWayMerge(paths, sink);
+}
+
+bool mergePartialFiles(const std::vector<std::string>& paths, PartialAggregate& out) {
+    AggregateSink sink(out);
+    return kWayMerge(paths, sink);
+}
@@ -0,0 +1,81 @@
+﻿#pragma once
+
+#include "attendance.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <iostream>
+
+// 사이트(프로세스)별 집계 결과를 합치기 위한 부분 집계본
+// 파일 형식 (텍스트, 이름 오름차순):
+//   ATTPART 2 <거부된 기록 수>           (버전 1 머리는 거부 수 0으로 읽음)
+//   <firstSeen> <name> <mon> <tue> <wed> <thu> <fri> <sat> <sun>
+struct PartialEntry {
+    unsigned long long firstSeen; // 최초 등장 순서 키 (작을수록 먼저 등장)
+    std::string name;
+    int dayCount[7];
+
+    PartialEntry() : firstSeen(0), name("") {
+        for (int i = 0; i < 7; ++i) dayCount[i] = 0;
+    }
+};
+
+class PartialAggregate {
+public:
+    PartialAggregate();
+
+    // Input
+    void addRecord(const std::string& name, Weekday day, unsigned long long firstSeen);
+    void addEntry(const PartialEntry& e); // 같은 이름이면 요일별 합산, firstSeen은 최소값
+    void addRejected(size_t records);     // 파싱 단계에서 거부된 기록 (잘못된 요일)
+    void merge(const PartialAggregate& other); // 결합법칙/교환법칙 성립 (거부 수도 합산)
+
+    // AttendanceSystem 연동
+    // keyBase는 사이트마다 달라야 함: 전체 로그에서 이 사이트 앞에 오는 기록 수를 주면
+    // 병합 후 ID가 한 번에 순차 처리한 결과와 같음 (firstSeen = keyBase + 사이트 내 등장 순서)
+    static PartialAggregate fromSystem(const AttendanceSystem& sys, unsigned long long keyBase);
+    void applyTo(AttendanceSystem& sys) const; // firstSeen 순으로 주입 (같으면 이름 순) -> ID 순서 보존, 거부 수도 넘김
+
+    // Serialize
+    void save(std::ostream& os) const;
+    bool load(std::istream& in);
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+
+    // Output
+    const std::vector<PartialEntry>& entries() const; // 삽입 순서
+    size_t size() const;
+    size_t rejectedCount() const; // 기록 단위 (applyTo에서 정규화로 거부되는 이름은 sys 쪽에서 셈)
+    void clear();
+
+private:
+    std::map<std::string, int> indexByName_;
+    std::vector<PartialEntry>  entries_;
+    size_t                     rejected_;
+};
+
+// 집계본 한 개를 앞에서부터 한 항목씩 읽음 (전체를 메모리에 올리지 않음)
+class PartialReader {
+public:
+    explicit PartialReader(std::istream& in);
+    bool ok() const;                // 헤더가 올바른지
+    bool next(PartialEntry& out);   // 더 읽을 항목이 없거나 형식 오류면 false
+    bool failed() const;            // 형식 오류 또는 이름 정렬 위반
+    size_t rejectedCount() const;   // 머리에 적힌 거부된 기록 수
+
+private:
+    std::istream& in_;
+    bool ok_, failed_;
+    size_t rejected_;
+    std::string lastName_;
+    bool hasLast_;
+};
+
+void writePartialHeader(std::ostream& os, size_t rejected = 0);
+void writePartialEntry(std::ostream& os, const PartialEntry& e);
+bool readPartialEntry(std::istream& in, PartialEntry& out); // 정렬 검사 없이 한 항목
+
+// K개 집계본 파일을 이름 순 k-way 병합 (스트리밍)
+bool mergePartialFiles(const std::vector<std::string>& paths, std::ostream& out);
+bool mergePartialFiles(const std::vector<std::string>& paths, PartialAggregate& out);
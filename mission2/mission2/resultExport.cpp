@@ -0,0 +1,244 @@
+﻿#include "resultExport.h"
+#include "nameNormalizer.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+const size_t kFlushBytes = 1u << 20; // 버퍼가 이만큼 차면 스트림으로 내보냄
+
+const char* kColumnNames[ExportColumnCount] = {
+    "id", "name", "mon", "tue", "wed", "thu", "fri", "sat", "sun",
+    "base", "bonus", "total", "grade", "eliminated"
+};
+
+inline bool selected(ColumnMask cols, int c) { return (cols >> c) & 1u; }
+
+int intValue(const PlayerStat& p, int c) {
+    switch (c) {
+    case ColId: return p.id;
+    case ColBasePoints: return p.basePoints;
+    case ColBonusPoints: return p.bonusPoints;
+    case ColTotalPoints: return p.totalPoints;
+    case ColEliminated: return p.eliminationCandidate ? 1 : 0;
+    default: return p.dayCount[c - ColMon]; // ColMon..ColSun
+    }
+}
+
+void appendInt(std::string& buf, long long v) {
+    char tmp[24];
+    char* end = tmp + sizeof(tmp);
+    char* p = end;
+    unsigned long long u = v < 0 ? 0ull - (unsigned long long)v : (unsigned long long)v;
+    do { *--p = (char)('0' + u % 10); u /= 10; } while (u);
+    if (v < 0) *--p = '-';
+    buf.append(p, end);
+}
+
+void appendU32(std::string& buf, unsigned v) {
+    char b[4] = { (char)(v & 0xff), (char)((v >> 8) & 0xff), (char)((v >> 16) & 0xff), (char)((v >> 24) & 0xff) };
+    buf.append(b, 4);
+}
+
+void appendCsvString(std::string& buf, const std::string& s) {
+    if (s.find_first_of(",\"\r\n") == std::string::npos) { buf += s; return; }
+    buf += '"';
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '"') buf += '"';
+        buf += s[i];
+    }
+    buf += '"';
+}
+
+void appendJsonString(std::string& buf, const std::string& s) {
+    static const char hex[] = "0123456789abcdef";
+    buf += '"';
+    for (size_t i = 0; i < s.size(); ++i) {
+        unsigned char c = (unsigned char)s[i];
+        if (c == '"' || c == '\\') { buf += '\\'; buf += (char)c; }
+        else if (c < 0x20) { buf += "\\u00"; buf += hex[c >> 4]; buf += hex[c & 15]; }
+        else if (c < 0x80) buf += (char)c;
+        else {
+            // 올바른 UTF-8 문자는 그대로, 잘못된 바이트는 Latin-1 문자(\u00XX)로 바꿔 항상 유효한 JSON을 만듦
+            size_t len = c >= 0xf0 ? 4 : c >= 0xe0 ? 3 : c >= 0xc0 ? 2 : 0;
+            if (len && i + len <= s.size() && isValidUtf8(&s[i], len)) { buf.append(s, i, len); i += len - 1; }
+            else { buf += "\\u00"; buf += hex[c >> 4]; buf += hex[c & 15]; }
+        }
+    }
+    buf += '"';
+}
+
+} // namespace
+
+const char* columnName(ExportColumn c) { return kColumnNames[(int)c]; }
+
+bool parseColumnList(const std::string& list, ColumnMask& out) {
+    ColumnMask mask = 0;
+    std::istringstream iss(list);
+    std::string name;
+    while (std::getline(iss, name, ',')) {
+        int c = 0;
+        while (c < ExportColumnCount && name != kColumnNames[c]) ++c;
+        if (c == ExportColumnCount) return false;
+        mask |= 1u << c;
+    }
+    if (mask == 0) return false;
+    out = mask;
+    return true;
+}
+
+// CsvResultWriter
+const char* CsvResultWriter::extension() const { return ".csv"; }
+
+void CsvResultWriter::begin(std::string& buf, ColumnMask cols) const {
+    bool first = true;
+    for (int c = 0; c < ExportColumnCount; ++c) {
+        if (!selected(cols, c)) continue;
+        if (!first) buf += ',';
+        buf += kColumnNames[c];
+        first = false;
+    }
+    buf += '\n';
+}
+
+void CsvResultWriter::writeRows(std::string& buf, const PlayerStat* rows, size_t count, ColumnMask cols) const {
+    for (size_t r = 0; r < count; ++r) {
+        const PlayerStat& p = rows[r];
+        bool first = true;
+        for (int c = 0; c < ExportColumnCount; ++c) {
+            if (!selected(cols, c)) continue;
+            if (!first) buf += ',';
+            first = false;
+            if (c == ColName) appendCsvString(buf, p.name);
+            else if (c == ColGrade) appendCsvString(buf, p.grade);
+            else appendInt(buf, intValue(p, c));
+        }
+        buf += '\n';
+    }
+}
+
+// JsonLinesResultWriter
+const char* JsonLinesResultWriter::extension() const { return ".jsonl"; }
+
+void JsonLinesResultWriter::begin(std::string&, ColumnMask) const {}
+
+void JsonLinesResultWriter::writeRows(std::string& buf, const PlayerStat* rows, size_t count, ColumnMask cols) const {
+    for (size_t r = 0; r < count; ++r) {
+        const PlayerStat& p = rows[r];
+        char sep = '{';
+        for (int c = 0; c < ExportColumnCount; ++c) {
+            if (!selected(cols, c)) continue;
+            buf += sep;
+            sep = ',';
+            buf += '"';
+            buf += kColumnNames[c];
+            buf += "\":";
+            if (c == ColName) appendJsonString(buf, p.name);
+            else if (c == ColGrade) appendJsonString(buf, p.grade);
+            else if (c == ColEliminated) buf += p.eliminationCandidate ? "true" : "false";
+            else appendInt(buf, intValue(p, c));
+        }
+        if (sep == '{') buf += '{';
+        buf += "}\n";
+    }
+}
+
+// ColumnarBinaryResultWriter
+const char* ColumnarBinaryResultWriter::extension() const { return ".bin"; }
+
+void ColumnarBinaryResultWriter::begin(std::string& buf, ColumnMask cols) const {
+    buf.append("ATTCOL1\0", 8);
+    appendU32(buf, cols);
+}
+
+void ColumnarBinaryResultWriter::writeRows(std::string& buf, const PlayerStat* rows, size_t count, ColumnMask cols) const {
+    if (count == 0) return;
+    appendU32(buf, (unsigned)count);
+    for (int c = 0; c < ExportColumnCount; ++c) {
+        if (!selected(cols, c)) continue;
+        if (c == ColName || c == ColGrade) {
+            unsigned offset = 0;
+            appendU32(buf, 0);
+            for (size_t r = 0; r < count; ++r) {
+                offset += (unsigned)(c == ColName ? rows[r].name : rows[r].grade).size();
+                appendU32(buf, offset);
+            }
+            for (size_t r = 0; r < count; ++r) buf += (c == ColName ? rows[r].name : rows[r].grade);
+        } else if (c == ColEliminated) {
+            for (size_t r = 0; r < count; ++r) buf += (char)(rows[r].eliminationCandidate ? 1 : 0);
+        } else {
+            for (size_t r = 0; r < count; ++r) appendU32(buf, (unsigned)intValue(rows[r], c));
+        }
+    }
+}
+
+// ResultExporter
+ResultExporter::ResultExporter(const AttendanceSystem& sys) : sys_(sys), cols_(AllColumns), chunkRows_(4096), threads_(0) {}
+
+void ResultExporter::setColumns(ColumnMask cols) { cols_ = cols & AllColumns; }
+
+void ResultExporter::setChunkRows(size_t rows) { if (rows > 0) chunkRows_ = rows; }
+
+void ResultExporter::setThreadCount(int threads) { threads_ = threads > 0 ? threads : 0; }
+
+bool ResultExporter::writeRange(std::ostream& os, const IResultWriter& writer, size_t begin, size_t end) const {
+    const PlayerList players = sys_.players();
+    std::string buf;
+    buf.reserve(kFlushBytes + kFlushBytes / 4);
+    writer.begin(buf, cols_);
+    for (size_t b = begin; b < end; b += chunkRows_) {
+        writer.writeRows(buf, &players[b], std::min(chunkRows_, end - b), cols_);
+        if (buf.size() >= kFlushBytes) { os.write(buf.data(), (std::streamsize)buf.size()); buf.clear(); }
+    }
+    os.write(buf.data(), (std::streamsize)buf.size());
+    return (bool)os;
+}
+
+bool ResultExporter::exportTo(std::ostream& os, const IResultWriter& writer) const {
+    return writeRange(os, writer, 0, sys_.players().size());
+}
+
+bool ResultExporter::exportToFile(const std::string& path, const IResultWriter& writer) const {
+    std::ofstream fout(path.c_str(), std::ios::out | std::ios::binary);
+    if (!fout.is_open()) { std::cerr << "Failed to open file: " << path << "\n"; return false; }
+    return exportTo(fout, writer);
+}
+
+bool ResultExporter::exportPartitioned(const std::string& prefix, size_t partitions, const IResultWriter& writer,
+                                       std::vector<std::string>* paths) const {
+    if (partitions == 0) partitions = 1;
+    std::vector<std::string> names(partitions);
+    for (size_t i = 0; i < partitions; ++i) {
+        std::ostringstream oss;
+        oss << prefix << "-" << (i < 100 ? "0" : "") << (i < 10 ? "0" : "") << i << writer.extension();
+        names[i] = oss.str();
+    }
+
+    const size_t total = sys_.players().size();
+    std::vector<char> ok(partitions, 0);
+    std::atomic<size_t> next(0);
+    size_t workers = threads_ > 0 ? (size_t)threads_ : (size_t)std::thread::hardware_concurrency();
+    workers = std::max((size_t)1, std::min(workers, partitions));
+
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < workers; ++t) {
+        pool.push_back(std::thread([&]() {
+            for (size_t i; (i = next++) < partitions;) {
+                std::ofstream fout(names[i].c_str(), std::ios::out | std::ios::binary);
+                if (!fout.is_open()) continue;
+                ok[i] = writeRange(fout, writer, total * i / partitions, total * (i + 1) / partitions) ? 1 : 0;
+            }
+        }));
+    }
+    for (size_t t = 0; t < pool.size(); ++t) pool[t].join();
+
+    bool all = true;
+    for (size_t i = 0; i < partitions; ++i) {
+        if (!ok[i]) { std::cerr << "Failed to write file: " << names[i] << "\n"; all = false; }
+    }
+    if (paths) paths->swap(names);
+    return all;
+}
@@ -0,0 +1,86 @@
+﻿#pragma once
+
+#include "attendance.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 내보낼 PlayerStat 필드 (열 순서 = 출력 순서)
+enum ExportColumn {
+    ColId = 0, ColName,
+    ColMon, ColTue, ColWed, ColThu, ColFri, ColSat, ColSun,
+    ColBasePoints, ColBonusPoints, ColTotalPoints, ColGrade, ColEliminated,
+    ExportColumnCount
+};
+
+typedef unsigned ColumnMask; // 비트 i = ExportColumn i
+const ColumnMask AllColumns = (1u << ExportColumnCount) - 1;
+
+inline ColumnMask columnBit(ExportColumn c) { return 1u << (int)c; }
+const char* columnName(ExportColumn c);                       // "id", "name", "mon", ..., "eliminated"
+bool parseColumnList(const std::string& list, ColumnMask& out); // "id,name,total" (모르는 이름이면 false)
+
+// 출력 형식 전략: 행 묶음을 미리 만든 버퍼 뒤에 이어 붙임 (ostream 필드 단위 호출 없음)
+// 상태가 없어야 함 -> 분할 파일을 여러 스레드가 같은 writer로 동시에 씀
+class IResultWriter {
+public:
+    virtual ~IResultWriter() {}
+    virtual const char* extension() const = 0;
+    virtual void begin(std::string& buf, ColumnMask cols) const = 0;  // 파일 머리
+    virtual void writeRows(std::string& buf, const PlayerStat* rows, size_t count, ColumnMask cols) const = 0;
+};
+
+// 첫 줄은 열 이름. 쉼표/따옴표/줄바꿈이 든 값은 따옴표로 감쌈
+class CsvResultWriter : public IResultWriter {
+public:
+    virtual const char* extension() const;
+    virtual void begin(std::string& buf, ColumnMask cols) const;
+    virtual void writeRows(std::string& buf, const PlayerStat* rows, size_t count, ColumnMask cols) const;
+};
+
+// 한 줄에 객체 하나 {"id":1,"name":"..."} (머리 없음 -> 분할 파일을 그대로 이어 붙일 수 있음)
+// 이름의 잘못된 UTF-8 바이트는 \u00XX 로 내보냄 (정규화 없이 읽은 이름도 유효한 JSON)
+class JsonLinesResultWriter : public IResultWriter {
+public:
+    virtual const char* extension() const;
+    virtual void begin(std::string& buf, ColumnMask cols) const;
+    virtual void writeRows(std::string& buf, const PlayerStat* rows, size_t count, ColumnMask cols) const;
+};
+
+// 리틀 엔디언 열 단위 바이너리
+//   머리   : "ATTCOL1\0" + u32 열 마스크
+//   묶음마다: u32 행 수, 이어서 선택한 열을 열 순서대로
+//             정수 열 = 행마다 i32, eliminated = 행마다 u8,
+//             문자열 열(name, grade) = u32 오프셋 (행 수 + 1) + UTF-8 바이트
+class ColumnarBinaryResultWriter : public IResultWriter {
+public:
+    virtual const char* extension() const;
+    virtual void begin(std::string& buf, ColumnMask cols) const;
+    virtual void writeRows(std::string& buf, const PlayerStat* rows, size_t count, ColumnMask cols) const;
+};
+
+// compute() 결과를 플레이어 저장소에서 바로 묶음 단위로 내보냄
+class ResultExporter {
+public:
+    explicit ResultExporter(const AttendanceSystem& sys);
+
+    void setColumns(ColumnMask cols);   // 기본 AllColumns
+    void setChunkRows(size_t rows);     // writeRows 한 번에 넘기는 행 수, 기본 4096
+    void setThreadCount(int threads);   // 분할 파일 동시 작성 수, 0 = 하드웨어 스레드 수
+
+    bool exportTo(std::ostream& os, const IResultWriter& writer) const;
+    bool exportToFile(const std::string& path, const IResultWriter& writer) const;
+
+    // 플레이어를 partitions개 연속 구간으로 나눠 <prefix>-000<ext> ... 로 병렬 작성
+    bool exportPartitioned(const std::string& prefix, size_t partitions, const IResultWriter& writer,
+                           std::vector<std::string>* paths = 0) const;
+
+private:
+    const AttendanceSystem& sys_;
+    ColumnMask cols_;
+    size_t chunkRows_;
+    int threads_;
+
+    bool writeRange(std::ostream& os, const IResultWriter& writer, size_t begin, size_t end) const;
+};